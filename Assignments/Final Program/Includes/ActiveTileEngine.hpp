@@ -0,0 +1,190 @@
+#pragma once
+
+#include "LifeEngine.hpp"
+#include "SimdEngine.hpp"
+#include "WorkStealing.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+// --------------------------------------------------------------
+// ActiveTileEngine:
+// Skips the parts of the board that are not changing.
+//
+// The grid is split into square tiles (64x64 by default). Each
+// tile remembers whether it changed in the last generation. A
+// tile is recomputed only if it or one of its 8 neighbor tiles
+// changed; otherwise it cannot change now either.
+//
+// Skipped tiles need no copy: a tile that did not change last
+// generation holds the same cells in the back buffer (one
+// generation older) as in the front buffer.
+//
+// Recomputed tiles use the SIMD row kernel on each tile row, and
+// compare the result with the old row to set the tile's flag.
+//
+// With setThreads(n > 1) the active tiles of each generation are
+// spread over n workers by a WorkStealingScheduler, so a board
+// whose activity sits in one corner still keeps every worker busy.
+// --------------------------------------------------------------
+class ActiveTileEngine : public LifeEngine {
+   private:
+    int tileSize;
+    RowRule rule;
+    LifeRowKernel kernel;
+
+    int rows = 0, cols = 0;
+    int tileRows = 0, tileCols = 0;
+    std::vector<uint8_t> changed;  // per tile: changed last generation?
+    std::vector<uint8_t> active;   // per tile: recompute this generation?
+    std::vector<int> work;         // indices of the active tiles
+    bool stale = true;             // back buffer unknown: recompute all
+    Boundary boundary = Boundary::Dead;
+
+    // Stats for the most recent generation
+    long activeCount = 0;
+    long long generations = 0, activeTotal = 0;
+
+    int threads = 1;
+    std::unique_ptr<WorkStealingScheduler> scheduler;  // built on the first threaded step
+
+    void resize(int r, int c) {
+        if (r == rows && c == cols)
+            return;
+        rows     = r;
+        cols     = c;
+        tileRows = (r + tileSize - 1) / tileSize;
+        tileCols = (c + tileSize - 1) / tileSize;
+        changed.assign((size_t)tileRows * tileCols, 1);
+        active.assign((size_t)tileRows * tileCols, 1);
+        work.reserve((size_t)tileRows * tileCols);
+        stale = true;
+    }
+
+    // Tile index one step past the edge: wraps for a toroidal board,
+    // is the tile itself for a mirrored one, and -1 (no neighbor) for
+    // constant boundaries, whose halo never changes.
+    int neighborTile(int t, int n, Boundary b) const {
+        return (t >= 0 && t < n) ? t : haloSource(t, n, b);
+    }
+
+    // active = changed, dilated by one tile in every direction
+    void markActive(Boundary b) {
+        std::fill(active.begin(), active.end(), stale);
+        activeCount = stale ? tileCount() : 0;
+        if (stale)
+            return;
+
+        for (int tr = 0; tr < tileRows; tr++) {
+            for (int tc = 0; tc < tileCols; tc++) {
+                if (!changed[(size_t)tr * tileCols + tc])
+                    continue;
+
+                for (int dr = -1; dr <= 1; dr++) {
+                    int nr = neighborTile(tr + dr, tileRows, b);
+                    for (int dc = -1; dc <= 1; dc++) {
+                        int nc = neighborTile(tc + dc, tileCols, b);
+                        if (nr < 0 || nc < 0)
+                            continue;
+
+                        uint8_t& flag = active[(size_t)nr * tileCols + nc];
+                        activeCount += !flag;
+                        flag = 1;
+                    }
+                }
+            }
+        }
+    }
+
+   public:
+    explicit ActiveTileEngine(const LifeRule& r = LifeRule::conway(), int size = 64)
+        : tileSize(size), rule(makeRowRule(r)), kernel(lifeRowKernel(detectSimdLevel(), r)) {
+    }
+
+    const char* name() const override {
+        return "tiles";
+    }
+
+    void run(CellBuffer& cur, CellBuffer& next, const GridLayout& layout, int gens) override {
+        resize(layout.rows, layout.cols);
+        boundary = layout.boundary;
+        LifeEngine::run(cur, next, layout, gens);
+    }
+
+    // Recompute tile t; sets its changed flag.
+    void stepTile(const GridView& src, uint8_t* dst, int t) {
+        int tr = t / tileCols, tc = t % tileCols;
+        int r0 = tr * tileSize, r1 = std::min(rows, r0 + tileSize);
+        int c0 = tc * tileSize, width = std::min(cols, c0 + tileSize) - c0;
+        int stride = src.rowStride();
+        bool diff  = false;
+
+        for (int r = r0; r < r1; r++) {
+            uint8_t* out = dst + (ptrdiff_t)r * stride + c0;
+            kernel(src[r - 1].begin() + c0, src[r].begin() + c0, src[r + 1].begin() + c0, out, width, rule);
+            diff = diff || std::memcmp(out, src[r].begin() + c0, width) != 0;
+        }
+        changed[t] = diff;
+    }
+
+    void step(const GridView& src, uint8_t* dst) override {
+        resize(src.rowCount(), src.colCount());
+        markActive(boundary);
+
+        work.clear();
+        for (int t = 0; t < tileCount(); t++) {
+            if (active[t])
+                work.push_back(t);
+            else
+                changed[t] = 0;
+        }
+
+        // Tiles write disjoint parts of 'dst' and their own flag
+        if (threads > 1 && work.size() > 1) {
+            if (!scheduler)
+                scheduler = std::make_unique<WorkStealingScheduler>(threads);
+            scheduler->run((int)work.size(), [&](int i) { stepTile(src, dst, work[i]); });
+        } else {
+            for (int t : work) stepTile(src, dst, t);
+        }
+
+        stale = false;
+        generations++;
+        activeTotal += activeCount;
+    }
+
+    void setThreads(int n) override {
+        threads = std::max(1, n);
+        scheduler.reset();
+    }
+
+    void invalidate() override {
+        LifeEngine::invalidate();
+        stale = true;
+    }
+
+    // Per-worker counters (empty until a threaded step ran)
+    std::vector<WorkStealingScheduler::WorkerStats> workerStats() const {
+        return scheduler ? scheduler->workerStats() : std::vector<WorkStealingScheduler::WorkerStats>();
+    }
+
+    // Tiles recomputed in the most recent generation
+    long activeTiles() const {
+        return activeCount;
+    }
+    long tileCount() const {
+        return (long)tileRows * tileCols;
+    }
+
+    void printStats(std::ostream& out) const override {
+        double average = generations ? (double)activeTotal / generations : 0.0;
+        out << "tiles: " << activeCount << " / " << tileCount() << " active last generation, " << average
+            << " on average over " << generations << " generations, " << threads << " thread(s)\n";
+        if (scheduler)
+            scheduler->printStats(out);
+    }
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+
+// --------------------------------------------------------------
+// Heap allocation counter (test hook).
+//
+// src/AllocCounter.cpp replaces the global operator new, so every
+// allocation made with new or by a standard container bumps one
+// counter. Programs that link that file can check that hot code
+// (step(), render()) stops allocating once it has warmed up.
+//
+// allocationCount() counts all threads; threadAllocationCount()
+// only the calling one, for code running next to other threads
+// that allocate (render() beside the simulation thread).
+//
+// Only C++ allocations are seen; malloc() inside SDL is not.
+// --------------------------------------------------------------
+size_t allocationCount();
+size_t threadAllocationCount();
+
+// --------------------------------------------------------------
+// AllocationScope:
+// Counts the allocations made while it is alive.
+//
+//     AllocationScope scope;
+//     gol.step();
+//     if (scope.count() != 0) ...
+// --------------------------------------------------------------
+class AllocationScope {
+   private:
+    size_t start;
+
+   public:
+    AllocationScope() : start(allocationCount()) {
+    }
+
+    size_t count() const {
+        return allocationCount() - start;
+    }
+};
+
+// The same, counting only the calling thread's allocations.
+class ThreadAllocationScope {
+   private:
+    size_t start;
+
+   public:
+    ThreadAllocationScope() : start(threadAllocationCount()) {
+    }
+
+    size_t count() const {
+        return threadAllocationCount() - start;
+    }
+};
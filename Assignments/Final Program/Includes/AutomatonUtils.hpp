@@ -1,5 +1,7 @@
 #pragma once
 #include <random>
+#include <stdexcept>
+#include <string>
 
 // --------------------------------------------------------------
 // Function: wrapIndex
@@ -30,3 +32,71 @@ inline int wrapIndex(int value, int max) {
     return result < 0 ? result + max  // fix negative remainder
                       : result;       // already in range
 }
+
+// --------------------------------------------------------------
+// Boundary:
+// What the cells just outside the board look like. The grid keeps
+// a "halo" (ghost border) that is filled from this policy before
+// every generation, so neighbor counting never has to check edges.
+//
+//   Dead      outside cells are always 0 (the classic board)
+//   Toroidal  the board wraps around: leaving the right edge
+//             re-enters on the left, top meets bottom
+//   Mirror    the board is reflected at each edge
+//   Alive     outside cells are always 1
+// --------------------------------------------------------------
+enum class Boundary { Dead, Toroidal, Mirror, Alive };
+
+inline const char* boundaryName(Boundary b) {
+    switch (b) {
+        case Boundary::Toroidal:
+            return "toroidal";
+        case Boundary::Mirror:
+            return "mirror";
+        case Boundary::Alive:
+            return "alive";
+        default:
+            return "dead";
+    }
+}
+
+// Dead and Alive halos never change once written.
+inline bool isConstantBoundary(Boundary b) {
+    return b == Boundary::Dead || b == Boundary::Alive;
+}
+
+// Parses the boundary= argument. Throws std::invalid_argument.
+inline Boundary parseBoundary(const std::string& name) {
+    if (name == "dead")
+        return Boundary::Dead;
+    if (name == "toroidal" || name == "torus" || name == "wrap")
+        return Boundary::Toroidal;
+    if (name == "mirror" || name == "mirrored")
+        return Boundary::Mirror;
+    if (name == "alive")
+        return Boundary::Alive;
+
+    throw std::invalid_argument("Unknown boundary: " + name + " (use dead, toroidal, mirror or alive)");
+}
+
+// --------------------------------------------------------------
+// Function: haloSource
+// Purpose : For an index 'i' just outside [0, n-1], return the
+//           index inside the board whose value it copies, or -1
+//           when the policy is a constant (Dead / Alive).
+//
+// Examples (n = 5):
+//   Toroidal: -1 -> 4,  5 -> 0   (uses wrapIndex)
+//   Mirror:   -1 -> 0,  5 -> 4,  -2 -> 1
+// --------------------------------------------------------------
+inline int haloSource(int i, int n, Boundary b) {
+    if (b == Boundary::Toroidal)
+        return wrapIndex(i, n);
+
+    if (b == Boundary::Mirror) {
+        int m = i < 0 ? -1 - i : (i >= n ? 2 * n - 1 - i : i);
+        return m < 0 ? 0 : (m >= n ? n - 1 : m);  // halo wider than the board
+    }
+
+    return -1;
+}
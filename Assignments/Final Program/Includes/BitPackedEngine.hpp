@@ -0,0 +1,326 @@
+#pragma once
+
+#include "LifeEngine.hpp"
+#include "LifeRule.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// --------------------------------------------------------------
+// lifeWord:
+// Conway's rules for 64 cells at once.
+//
+// Each argument holds one neighbor (or the cell itself) for 64
+// different cells, one cell per bit:
+//
+//     nw  n  ne
+//      w  me  e
+//     sw  s  se
+//
+// The eight neighbor bits are added with bit-sliced full/half
+// adders, giving the count in binary as three words (ones, twos,
+// fours). A count of 8 wraps to 0, which is harmless because
+// only 2 and 3 matter:
+//
+//     next = (count == 3) || (alive && count == 2)
+//          = twos & ~fours & (ones | alive)
+// --------------------------------------------------------------
+inline uint64_t lifeWord(uint64_t nw, uint64_t n, uint64_t ne, uint64_t w, uint64_t me, uint64_t e, uint64_t sw,
+                         uint64_t s, uint64_t se) {
+    // Row above: full adder (3 bits -> 2-bit sum)
+    uint64_t topX    = nw ^ n;
+    uint64_t topOnes = topX ^ ne;
+    uint64_t topTwos = (nw & n) | (ne & topX);
+
+    // Row below: full adder
+    uint64_t botX    = sw ^ s;
+    uint64_t botOnes = botX ^ se;
+    uint64_t botTwos = (sw & s) | (se & botX);
+
+    // Own row: half adder (the cell itself is not counted)
+    uint64_t midOnes = w ^ e;
+    uint64_t midTwos = w & e;
+
+    // Add the three ones-bits
+    uint64_t onesX = topOnes ^ botOnes;
+    uint64_t ones  = onesX ^ midOnes;
+    uint64_t carry = (topOnes & botOnes) | (midOnes & onesX);
+
+    // Add the four twos-bits (three partial sums + the carry)
+    uint64_t twosA = topTwos ^ botTwos;
+    uint64_t twosB = midTwos ^ carry;
+    uint64_t twos  = twosA ^ twosB;
+    uint64_t fours = (topTwos & botTwos) ^ (midTwos & carry) ^ (twosA & twosB);
+
+    return twos & ~fours & (ones | me);
+}
+
+// --------------------------------------------------------------
+// ruleWord<Mask>:
+// lifeWord() for any Life-like rule (see LifeRule::mask).
+//
+// The neighbor count is added up in full this time (ones, twos,
+// fours, eights: 0..8), then every count in the rule is matched:
+//
+//     next = (~alive & OR of count == n, n in birth)
+//          | ( alive & OR of count == n, n in survive)
+//
+// With a constant Mask the comparisons for counts not in the rule
+// vanish at compile time, so hot rules cost about what Conway
+// does; RUNTIME_RULE reads 'ruleMask' instead. Conway's own mask
+// uses the shorter lifeWord().
+// --------------------------------------------------------------
+template <uint32_t Mask>
+inline uint64_t ruleWord(uint32_t ruleMask, uint64_t nw, uint64_t n, uint64_t ne, uint64_t w, uint64_t me,
+                         uint64_t e, uint64_t sw, uint64_t s, uint64_t se) {
+    if constexpr (Mask == LifeRule::conway().mask()) {
+        (void)ruleMask;
+        return lifeWord(nw, n, ne, w, me, e, sw, s, se);
+    } else {
+        if constexpr (Mask != RUNTIME_RULE)
+            ruleMask = Mask;
+
+        // Same adder tree as lifeWord(), keeping the carry into 8
+        uint64_t topX    = nw ^ n;
+        uint64_t topOnes = topX ^ ne;
+        uint64_t topTwos = (nw & n) | (ne & topX);
+        uint64_t botX    = sw ^ s;
+        uint64_t botOnes = botX ^ se;
+        uint64_t botTwos = (sw & s) | (se & botX);
+        uint64_t midOnes = w ^ e;
+        uint64_t midTwos = w & e;
+
+        uint64_t onesX  = topOnes ^ botOnes;
+        uint64_t ones   = onesX ^ midOnes;
+        uint64_t carry  = (topOnes & botOnes) | (midOnes & onesX);
+        uint64_t twosA  = topTwos ^ botTwos;
+        uint64_t twosB  = midTwos ^ carry;
+        uint64_t twos   = twosA ^ twosB;
+        uint64_t fours  = (topTwos & botTwos) ^ (midTwos & carry) ^ (twosA & twosB);
+        uint64_t eights = topTwos & botTwos & midTwos & carry;  // all four twos: count 8
+
+        uint64_t born = 0, keep = 0;
+#pragma GCC unroll 9
+        for (int k = 0; k <= 8; k++) {
+            uint64_t is = ((k & 1) ? ones : ~ones) & ((k & 2) ? twos : ~twos) & ((k & 4) ? fours : ~fours) &
+                          ((k & 8) ? eights : ~eights);
+            if ((ruleMask >> k) & 1)
+                born |= is;
+            if ((ruleMask >> (9 + k)) & 1)
+                keep |= is;
+        }
+        return (born & ~me) | (keep & me);
+    }
+}
+
+// --------------------------------------------------------------
+// stepPackedRows:
+// One generation over a bit-packed board with a one-cell halo.
+//
+// Buffer row 0 and row rows+1 are the halo rows; row r+1 holds
+// board row r, 'words' words per row. Bit 0 of word 0 is the left
+// halo column, so board column c is bit (c + 1). 'mask[k]' keeps
+// only the board bits of word k, so halo bits in 'next' stay 0
+// until the halo is refilled.
+//
+// Rule is a rule mask or RUNTIME_RULE (then 'ruleMask' is used).
+// --------------------------------------------------------------
+template <uint32_t Rule = LifeRule::conway().mask()>
+inline void stepPackedRows(const uint64_t* cur, uint64_t* next, int rows, int words, const uint64_t* mask,
+                           uint32_t ruleMask = Rule) {
+    for (int r = 1; r <= rows; r++) {
+        const uint64_t* up   = cur + (size_t)(r - 1) * words;
+        const uint64_t* mid  = cur + (size_t)r * words;
+        const uint64_t* down = cur + (size_t)(r + 1) * words;
+        uint64_t* out        = next + (size_t)r * words;
+
+        for (int k = 0; k < words; k++) {
+            // Neighboring words (0 past the ends; the halo bits are inside)
+            bool first = k == 0, last = k + 1 == words;
+            uint64_t a = up[k], aL = first ? 0 : up[k - 1], aR = last ? 0 : up[k + 1];
+            uint64_t b = mid[k], bL = first ? 0 : mid[k - 1], bR = last ? 0 : mid[k + 1];
+            uint64_t c = down[k], cL = first ? 0 : down[k - 1], cR = last ? 0 : down[k + 1];
+
+            // West neighbor of column j is column j - 1: shift left,
+            // pulling bit 63 of the previous word into bit 0.
+            // East neighbor is the mirror image.
+            uint64_t cell = ruleWord<Rule>(ruleMask, (a << 1) | (aL >> 63), a, (a >> 1) | (aR << 63),
+                                           (b << 1) | (bL >> 63), b, (b >> 1) | (bR << 63),
+                                           (c << 1) | (cL >> 63), c, (c >> 1) | (cR << 63));
+
+            out[k] = cell & mask[k];
+        }
+    }
+}
+
+// --------------------------------------------------------------
+// unpackBits(in, first, out, n):
+// Writes bits first .. first+n-1 of the packed row 'in' to 'out'
+// as 0/1 bytes, eight at a time through a 256-entry table (one
+// byte of bits -> eight bytes), with the rest done bit by bit.
+// --------------------------------------------------------------
+inline void unpackBits(const uint64_t* in, int first, uint8_t* out, int n) {
+    struct Spread {
+        uint8_t bytes[256][8];
+        Spread() {
+            for (int b = 0; b < 256; b++)
+                for (int i = 0; i < 8; i++) bytes[b][i] = (b >> i) & 1;
+        }
+    };
+    static const Spread spread;
+
+    int c = 0;
+    for (; c + 64 <= n; c += 64) {
+        int bit    = first + c;
+        uint64_t w = in[bit >> 6] >> (bit & 63);
+        if (bit & 63)
+            w |= in[(bit >> 6) + 1] << (64 - (bit & 63));
+        for (int j = 0; j < 8; j++) std::memcpy(out + c + 8 * j, spread.bytes[(w >> (8 * j)) & 0xFF], 8);
+    }
+    for (; c < n; c++) out[c] = (in[(first + c) >> 6] >> ((first + c) & 63)) & 1;
+}
+
+// --------------------------------------------------------------
+// BitPackedEngine:
+// Stores 64 cells per uint64_t and computes a whole word of the
+// next generation at a time with lifeWord() / ruleWord().
+//
+// The packed board is kept between calls, so run(gens) only packs
+// the byte grid when it was edited (invalidate()) and unpacks once
+// at the end. The halo is rebuilt in packed form every generation
+// from the grid's boundary policy, so all policies are supported.
+// --------------------------------------------------------------
+class BitPackedEngine : public LifeEngine {
+   private:
+    std::vector<uint64_t> cur, next;  // packed boards with halo (ping-pong)
+    std::vector<uint64_t> mask;       // board bits of each word
+    int rows = 0, cols = 0, words = 0;
+    bool packed = false;  // does 'cur' match the byte grid?
+
+    // stepPackedRows instance for the rule
+    using PackedStep = void (*)(const uint64_t*, uint64_t*, int, int, const uint64_t*, uint32_t);
+    uint32_t ruleMask;
+    PackedStep stepRows;
+
+    uint64_t* row(std::vector<uint64_t>& board, int r) {  // r = -1 .. rows
+        return &board[(size_t)(r + 1) * words];
+    }
+
+    static bool getBit(const uint64_t* w, int bit) {
+        return (w[bit >> 6] >> (bit & 63)) & 1;
+    }
+    static void setBit(uint64_t* w, int bit, bool value) {
+        uint64_t m = 1ULL << (bit & 63);
+        w[bit >> 6] = value ? (w[bit >> 6] | m) : (w[bit >> 6] & ~m);
+    }
+
+    void resize(int r, int c) {
+        if (r == rows && c == cols)
+            return;
+        rows  = r;
+        cols  = c;
+        words = (c + 2 + 63) / 64;
+        cur.assign((size_t)(rows + 2) * words, 0);
+        next.assign((size_t)(rows + 2) * words, 0);
+
+        mask.assign(words, 0);
+        for (int bit = 1; bit <= cols; bit++) mask[bit >> 6] |= 1ULL << (bit & 63);
+        packed = false;
+    }
+
+    // Halo columns (bits 0 and cols+1), then halo rows, like fillHalo().
+    void fillPackedHalo(Boundary b) {
+        for (int r = 0; r < rows; r++) {
+            uint64_t* w = row(cur, r);
+            int left    = haloSource(-1, cols, b);
+            int right   = haloSource(cols, cols, b);
+
+            setBit(w, 0, left < 0 ? b == Boundary::Alive : getBit(w, left + 1));
+            setBit(w, cols + 1, right < 0 ? b == Boundary::Alive : getBit(w, right + 1));
+        }
+
+        for (int r : {-1, rows}) {
+            int src = haloSource(r, rows, b);
+            for (int k = 0; k < words; k++)
+                row(cur, r)[k] = src >= 0 ? row(cur, src)[k] : (b == Boundary::Alive ? ~0ULL : 0);
+        }
+    }
+
+   public:
+    explicit BitPackedEngine(const LifeRule& rule = LifeRule::conway())
+        : ruleMask(rule.mask()), stepRows(dispatchRule(rule.mask(), [](auto m) -> PackedStep {
+              return stepPackedRows<decltype(m)::value>;
+          })) {
+    }
+
+    const char* name() const override {
+        return "bitpacked";
+    }
+
+    // Copy a byte grid into 'cur'.
+    void pack(const GridView& src) {
+        resize(src.rowCount(), src.colCount());
+        for (int r = 0; r < rows; r++) {
+            const uint8_t* in = src[r].begin();
+            uint64_t* out     = row(cur, r);
+
+            for (int k = 0; k < words; k++) out[k] = 0;
+            for (int c = 0; c < cols; c++) out[(c + 1) >> 6] |= (uint64_t)(in[c] & 1) << ((c + 1) & 63);
+        }
+        packed = true;
+    }
+
+    // Copy 'cur' back out to a byte grid.
+    void unpack(uint8_t* dst, int stride) {
+        for (int r = 0; r < rows; r++) unpackBits(row(cur, r), 1, dst + (ptrdiff_t)r * stride, cols);
+    }
+
+    // Advance the packed board without touching any bytes.
+    void advance(int gens, Boundary b) {
+        for (int g = 0; g < gens; g++) {
+            fillPackedHalo(b);
+            stepRows(cur.data(), next.data(), rows, words, mask.data(), ruleMask);
+            cur.swap(next);
+        }
+    }
+
+    void step(const GridView& src, uint8_t* dst) override {
+        // Single generation: the byte halo is already filled, so
+        // copy it in as a "dead" board with the real edge bits.
+        resize(src.rowCount(), src.colCount());
+        for (int r = -1; r <= rows; r++) {
+            uint64_t* out = row(cur, r);
+            for (int k = 0; k < words; k++) out[k] = 0;
+            for (int c = -1; c <= cols; c++) out[(c + 1) >> 6] |= (uint64_t)(src[r][c] & 1) << ((c + 1) & 63);
+        }
+        stepRows(cur.data(), next.data(), rows, words, mask.data(), ruleMask);
+        cur.swap(next);
+        unpack(dst, src.rowStride());
+        packed = false;  // the caller now owns which buffer is current
+    }
+
+    void run(CellBuffer& grid, CellBuffer&, const GridLayout& layout, int gens) override {
+        GridView view(grid.data() + layout.origin(), layout.rows, layout.cols, layout.stride);
+
+        if (!packed || layout.rows != rows || layout.cols != cols)
+            pack(view);
+
+        advance(gens, layout.boundary);
+        unpack(grid.data() + layout.origin(), layout.stride);
+    }
+
+    void invalidate() override {
+        LifeEngine::invalidate();
+        packed = false;
+    }
+
+    bool needsScratch() const override {  // steps its own packed boards
+        return false;
+    }
+
+    // Bytes of packed storage per cell (about 1/8).
+    double bytesPerCell() const {
+        return (double)cur.size() * sizeof(uint64_t) / ((double)rows * cols);
+    }
+};
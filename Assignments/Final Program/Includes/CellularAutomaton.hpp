@@ -1,7 +1,151 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
+#include "AutomatonUtils.hpp"
+#include "GridMemory.hpp"
+
+// --------------------------------------------------------------
+// GridView:
+// A read-only window onto a row-major byte grid.
+//
+// It behaves like the old std::vector<std::vector<int>> for
+// callers that only read the board:
+//
+//     grid.size()       -> number of rows
+//     grid[r].size()    -> number of columns
+//     grid[r][c]        -> state of cell (r, c)
+//
+// Rows are 'stride' bytes apart in memory, so a view can point at
+// a buffer that carries extra padding around each row. Views made
+// by CellularAutomaton sit inside a filled halo, so grid[-1][c] and
+// grid[r][cols] are readable too.
+// --------------------------------------------------------------
+class GridView {
+   public:
+    // One row of the grid (pointer + length, like a span).
+    class Row {
+       private:
+        const uint8_t* cells;
+        int length;
+
+       public:
+        Row(const uint8_t* data, int n) : cells(data), length(n) {
+        }
+
+        uint8_t operator[](int c) const {
+            return cells[c];
+        }
+        int size() const {
+            return length;
+        }
+        const uint8_t* begin() const {
+            return cells;
+        }
+        const uint8_t* end() const {
+            return cells + length;
+        }
+    };
+
+    GridView(const uint8_t* data, int r, int c, int s) : base(data), rows(r), cols(c), stride(s) {
+    }
+
+    Row operator[](int r) const {
+        return Row(base + (ptrdiff_t)r * stride, cols);
+    }
+
+    int size() const {
+        return rows;
+    }
+    int rowCount() const {
+        return rows;
+    }
+    int colCount() const {
+        return cols;
+    }
+    int rowStride() const {
+        return stride;
+    }
+    const uint8_t* data() const {
+        return base;
+    }
+
+   private:
+    const uint8_t* base;  // first cell of row 0
+    int rows, cols;       // visible dimensions
+    int stride;           // bytes between the start of consecutive rows
+};
+
+// --------------------------------------------------------------
+// GridLayout:
+// Where the cells live inside a halo-padded buffer.
+//
+//     buffer: (rows + 2*halo) x stride bytes, stride = cols + 2*halo
+//     cell (r, c) -> buffer[(r + halo) * stride + (c + halo)]
+//
+// r and c may run from -halo to rows-1+halo / cols-1+halo.
+// --------------------------------------------------------------
+struct GridLayout {
+    int rows, cols;     // visible cells
+    int halo;           // ghost cells on every side
+    int stride;         // bytes per buffer row
+    Boundary boundary;  // how the halo is filled
+
+    size_t origin() const {  // buffer index of cell (0, 0)
+        return (size_t)halo * stride + halo;
+    }
+    size_t bufferSize() const {
+        return (size_t)(rows + 2 * halo) * stride;
+    }
+};
+
+// --------------------------------------------------------------
+// fillHalo(buffer, layout):
+// Writes the ghost border around the visible cells according to
+// layout.boundary. Costs O(perimeter), once per generation.
+//
+// Side columns of every visible row are filled first; the halo
+// rows are then copied whole from their source rows, which gives
+// the corners for free.
+// --------------------------------------------------------------
+inline void fillHalo(uint8_t* buffer, const GridLayout& g) {
+    const int h   = g.halo;
+    uint8_t* base = buffer + g.origin();
+    auto row      = [&](int r) { return base + (ptrdiff_t)r * g.stride; };
+
+    if (h == 0 || g.rows == 0 || g.cols == 0)
+        return;
+
+    if (g.boundary == Boundary::Dead || g.boundary == Boundary::Alive) {
+        uint8_t value = g.boundary == Boundary::Alive;
+        for (int r = 0; r < g.rows; r++) {
+            std::memset(row(r) - h, value, h);
+            std::memset(row(r) + g.cols, value, h);
+        }
+        for (int k = 1; k <= h; k++) {
+            std::memset(row(-k) - h, value, g.stride);
+            std::memset(row(g.rows - 1 + k) - h, value, g.stride);
+        }
+        return;
+    }
+
+    for (int r = 0; r < g.rows; r++) {
+        uint8_t* cells = row(r);
+        for (int k = 1; k <= h; k++) {
+            cells[-k]             = cells[haloSource(-k, g.cols, g.boundary)];
+            cells[g.cols - 1 + k] = cells[haloSource(g.cols - 1 + k, g.cols, g.boundary)];
+        }
+    }
+    for (int k = 1; k <= h; k++) {
+        std::memcpy(row(-k) - h, row(haloSource(-k, g.rows, g.boundary)) - h, g.stride);
+        std::memcpy(row(g.rows - 1 + k) - h, row(haloSource(g.rows - 1 + k, g.rows, g.boundary)) - h, g.stride);
+    }
+}
+
 // --------------------------------------------------------------
 // Base class for 2D Cellular Automata.
 // This provides the grid structure and general utilities,
@@ -17,17 +161,53 @@
 // --------------------------------------------------------------
 class CellularAutomaton {
    protected:
-    int rows, cols;  // Dimensions of the grid (rows x columns)
+    int rows, cols;     // Dimensions of the grid (rows x columns)
+    int halo;           // Ghost cells on each side of the grid
+    int stride;         // Bytes between the start of consecutive rows
+    Boundary boundary;  // How the halo is filled
 
-    // 2D grid storing integer states.
+    // Flat row-major grid storing one byte per cell, surrounded by
+    // a 'halo' of ghost cells (see GridLayout).
     // Many automata use 0 = dead, 1 = alive, but derived classes may extend this.
-    std::vector<std::vector<int>> grid;
+    CellBuffer cells;
+
+    // Direct cell access for derived classes (no bounds checks).
+    // Valid from -halo to rows-1+halo (and the same for columns).
+    uint8_t& at(int r, int c) {
+        return cells[(size_t)(r + halo) * stride + (c + halo)];
+    }
+    uint8_t at(int r, int c) const {
+        return cells[(size_t)(r + halo) * stride + (c + halo)];
+    }
+
+    // Refresh the halo of 'cells' from the boundary policy.
+    void fillHalo() {
+        fillHalo(cells);
+    }
+    void fillHalo(CellBuffer& buffer) const {
+        ::fillHalo(buffer.data(), layout());
+    }
+
+    // ----------------------------------------------------------
+    // cellsChanged(): called after cells are edited from outside
+    // step() (randomize, setCell, clear, ...). Derived classes that
+    // cache state derived from the grid override this.
+    // ----------------------------------------------------------
+    virtual void cellsChanged() {
+    }
 
    public:
     // ----------------------------------------------------------
     // Constructor initializes grid size and sets all cells to 0.
+    // 'h' is the halo width (1 is enough for 3x3 neighborhoods).
     // ----------------------------------------------------------
-    CellularAutomaton(int r, int c) : rows(r), cols(c), grid(r, std::vector<int>(c, 0)) {
+    CellularAutomaton(int r, int c, int h = 1)
+        : rows(r),
+          cols(c),
+          halo(h),
+          stride(c + 2 * h),
+          boundary(Boundary::Dead),
+          cells((size_t)(r + 2 * h) * (c + 2 * h), 0) {
     }
 
     // Virtual destructor for safe polymorphic deletion.
@@ -39,19 +219,45 @@ class CellularAutomaton {
     // ----------------------------------------------------------
     virtual void step() = 0;
 
+    // ----------------------------------------------------------
+    // step(gens): Advance several generations in one call.
+    // Derived classes with a faster multi-generation path
+    // (engines, HashLife jumps) override this.
+    // ----------------------------------------------------------
+    virtual void step(int gens) {
+        for (int g = 0; g < gens; g++) step();
+    }
+
     // ----------------------------------------------------------
     // display(): Print or visualize the automaton.
     // Pure virtual → derived classes MUST implement this.
     // ----------------------------------------------------------
     virtual void display() const = 0;
 
+    // ----------------------------------------------------------
+    // printStats(): Report model-specific statistics (engine
+    // activity, memory use, ...). Prints nothing by default.
+    // ----------------------------------------------------------
+    virtual void printStats(std::ostream& out) const {
+        (void)out;
+    }
+
+    // ----------------------------------------------------------
+    // stateCount(): Number of cell states (0 = dead). Renderers
+    // use it to pick a palette; two-state automata keep the default.
+    // ----------------------------------------------------------
+    virtual int stateCount() const {
+        return 2;
+    }
+
     // ----------------------------------------------------------
     // countNeighbors:
     // Counts all orthogonal + diagonal neighbors around (r, c)
     // that are equal to 1 (typical for Game of Life).
     //
-    // NOTE: Does NOT wrap around by default
-    //       (students can override or extend this).
+    // NOTE: Edge cells read their neighbors from the halo, so the
+    //       result follows the boundary policy (dead by default).
+    //       The halo must be current: call fillHalo() first.
     // ----------------------------------------------------------
     int countNeighbors(int r, int c) const {
         int count = 0;
@@ -61,13 +267,9 @@ class CellularAutomaton {
                 if (dr == 0 && dc == 0)
                     continue;  // skip the cell itself
 
-                int nr = r + dr;
-                int nc = c + dc;
-
-                // Boundary check (no wrapping)
-                if (nr >= 0 && nr < rows && nc >= 0 && nc < cols)
-                    if (grid[nr][nc] == 1)
-                        count++;
+                // No boundary check: the halo is always there
+                if (at(r + dr, c + dc) == 1)
+                    count++;
             }
         }
 
@@ -83,17 +285,80 @@ class CellularAutomaton {
     void randomize(double density) {
         for (int r = 0; r < rows; r++) {
             for (int c = 0; c < cols; c++) {
-                double x   = (double)rand() / RAND_MAX;
-                grid[r][c] = (x < density) ? 1 : 0;
+                double x = (double)rand() / RAND_MAX;
+                at(r, c) = (x < density) ? 1 : 0;
             }
         }
+        cellsChanged();
+    }
+
+    // ----------------------------------------------------------
+    // Cell editing (used by the SDL driver for mouse / key input).
+    // Out-of-range coordinates are ignored. Models whose kernels
+    // need values in 0..stateCount()-1 override setCell().
+    // ----------------------------------------------------------
+    int getCell(int r, int c) const {
+        return inBounds(r, c) ? at(r, c) : 0;
+    }
+
+    virtual void setCell(int r, int c, int value) {
+        if (inBounds(r, c)) {
+            at(r, c) = (uint8_t)value;
+            cellsChanged();
+        }
+    }
+
+    void toggleCell(int r, int c) {
+        if (inBounds(r, c)) {
+            at(r, c) = !at(r, c);
+            cellsChanged();
+        }
+    }
+
+    // Set every cell to 0.
+    void clear() {
+        for (int r = 0; r < rows; r++)
+            for (int c = 0; c < cols; c++) at(r, c) = 0;
+        cellsChanged();
+    }
+
+    bool inBounds(int r, int c) const {
+        return r >= 0 && r < rows && c >= 0 && c < cols;
+    }
+
+    // ----------------------------------------------------------
+    // Boundary policy (dead, toroidal, mirror, alive).
+    // Takes effect from the next generation.
+    // ----------------------------------------------------------
+    void setBoundary(Boundary b) {
+        boundary = b;
+        cellsChanged();
+    }
+    Boundary getBoundary() const {
+        return boundary;
+    }
+
+    GridLayout layout() const {
+        return GridLayout{rows, cols, halo, stride, boundary};
+    }
+
+    int getRows() const {
+        return rows;
+    }
+    int getCols() const {
+        return cols;
+    }
+
+    // Bytes of cell storage per visible cell (about 1.0 plus the halo).
+    double bytesPerCell() const {
+        return (double)cells.capacity() / ((double)rows * cols);
     }
 
     // ----------------------------------------------------------
     // Accessor for grid (read-only).
     // Lets tests or models inspect output state.
     // ----------------------------------------------------------
-    const std::vector<std::vector<int>>& getGrid() const {
-        return grid;
+    GridView getGrid() const {
+        return GridView(cells.data() + layout().origin(), rows, cols, stride);
     }
 };
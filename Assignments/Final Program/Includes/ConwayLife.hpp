@@ -1,23 +1,178 @@
 #pragma once
 
+#include "ActiveTileEngine.hpp"
+#include "BitPackedEngine.hpp"
 #include "CellularAutomaton.hpp"
+#include "GridMemory.hpp"
+#include "FrontierEngine.hpp"
+#include "LifeEngine.hpp"
+#include "LifeRule.hpp"
+#include "LookupEngine.hpp"
+#include "Parallel.hpp"
+#include "RunningSumEngine.hpp"
+#include "SimdEngine.hpp"
+#include "TemporalBlockEngine.hpp"
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 class ConwayLife : public CellularAutomaton {
+   private:
+    // Optional faster backend. nullptr = the countNeighbors() loop below.
+    std::unique_ptr<LifeEngine> engine;
+
+    // The rule every engine applies (B3/S23 unless setRule() is called).
+    LifeRule rule = LifeRule::conway();
+
+    // Back buffer: the next generation is written here, then swapped
+    // with 'cells' in O(1). Allocated once, so stepping never allocates.
+    // Empty while the engine steps its own copy of the board
+    // (LifeEngine::needsScratch), e.g. bitpacked.
+    CellBuffer back;
+
+    // Row-band threading (see setThreads). The pool and the per-band
+    // engines are built on the first threaded step and kept.
+    int threads = defaultThreadCount();
+    std::unique_ptr<ThreadPool> pool;
+    std::vector<std::unique_ptr<LifeEngine>> bandEngines;
+
+    // Buffer placement (see setMemory / setPinning)
+    GridMemory memory  = GridMemory::Heap;
+    CpuPinning pinning = CpuPinning::None;
+
+    bool usesBands() const;
+    bool needsBack() const;
+    void fitBack();  // allocate or free 'back' per needsBack()
+    ThreadPool& bandPool();  // built on first use, pinned per 'pinning'
+    void placeBuffers();
+    void stepBands(int gens);
+    void stepRows(int first, int last);  // countNeighbors loop, rows [first, last)
+
+   protected:
+    void cellsChanged() override;  // tell the engine its cache is stale
+
    public:
     ConwayLife(int r, int c);
-    void step() override;           // Conway's rules
+    void step() override;           // Conway's rules (or the rule set by setRule)
+    void step(int gens) override;   // several generations in one call
     void display() const override;  // ASCII visualization
+    void printStats(std::ostream& out) const override;  // engine name + engine stats
+
+    // Select a backend by name (see makeLifeEngine()).
+    // Throws std::invalid_argument for unknown names.
+    void setEngine(const std::string& name);
+    std::string engineName() const;
+
+    // Any Life-like rule (e.g. LifeRule::parse("B36/S23")). The
+    // current engine is rebuilt for it.
+    void setRule(const LifeRule& r);
+    const LifeRule& getRule() const {
+        return rule;
+    }
+
+    // Current engine (nullptr for "scalar"), e.g. for printStats().
+    const LifeEngine* getEngine() const {
+        return engine.get();
+    }
+
+    // ----------------------------------------------------------
+    // setThreads(n):
+    // Step the board as n row bands on a persistent ThreadPool,
+    // with a barrier after every generation (default: one band
+    // per hardware thread). Each band reads the shared front
+    // buffer and writes only its own rows of the back buffer, so
+    // the result is identical for any n.
+    //
+    // Applies to "scalar" and engines whose splitsIntoBands() is
+    // true. "tiles" instead hands its active tiles to n workers
+    // with work stealing (LifeEngine::setThreads); frontier,
+    // bitpacked and blocked keep stepping on the calling thread.
+    // ----------------------------------------------------------
+    void setThreads(int n);
+    int getThreads() const {
+        return threads;
+    }
+
+    // ----------------------------------------------------------
+    // setMemory(mode):
+    // Move both cell buffers into 'mode' memory (see GridMemory),
+    // keeping the board. The new pages are first written by the
+    // thread that steps them: band b's rows by worker b, so on a
+    // NUMA host each band lives on its worker's node. Huge-page
+    // buffers are placed again whenever the bands change
+    // (setThreads, setEngine, setPinning).
+    //
+    // setPinning(policy) binds the band workers to CPUs (band 0
+    // stays on the calling thread). Only row bands use it.
+    // ----------------------------------------------------------
+    void setMemory(GridMemory mode);
+    GridMemory getMemory() const {
+        return memory;
+    }
+    void setPinning(CpuPinning policy);
+    CpuPinning getPinning() const {
+        return pinning;
+    }
 };
 
+// --------------------------------------------------------------
+// makeLifeEngine(name):
+// Factory for the engine= argument. "scalar" returns nullptr,
+// which means ConwayLife uses its own countNeighbors() loop.
+// Every engine applies 'rule'.
+//
+//   simd        best of avx2 / sse2 / branchless for this CPU
+//   avx2, sse2  force an instruction set (throws if unsupported)
+//   branchless  the SIMD engine's plain C++ fallback
+//   bitpacked   64 cells per uint64_t
+//   runningsum  separable column-sum + sliding-window counts
+//   lookup      4x4 -> 2x2 table, four cells per read
+//   tiles       SIMD kernel on 64x64 tiles, skipping unchanged areas
+//   frontier    only cells next to last generation's changes
+//   blocked     bit-packed tiles advanced up to 16 generations in
+//               cache per pass over memory (use step(n), n > 1)
+// --------------------------------------------------------------
+inline std::unique_ptr<LifeEngine> makeLifeEngine(const std::string& name,
+                                                  const LifeRule& rule = LifeRule::conway()) {
+    if (name == "scalar")
+        return nullptr;
+    if (name == "simd")
+        return std::make_unique<SimdEngine>(rule);
+    if (name == "avx2")
+        return std::make_unique<SimdEngine>(SimdLevel::AVX2, rule);
+    if (name == "sse2")
+        return std::make_unique<SimdEngine>(SimdLevel::SSE2, rule);
+    if (name == "branchless")
+        return std::make_unique<SimdEngine>(SimdLevel::Scalar, rule);
+    if (name == "bitpacked")
+        return std::make_unique<BitPackedEngine>(rule);
+    if (name == "runningsum")
+        return std::make_unique<RunningSumEngine>(rule);
+    if (name == "lookup")
+        return std::make_unique<LookupEngine>(rule);
+    if (name == "tiles")
+        return std::make_unique<ActiveTileEngine>(rule);
+    if (name == "frontier")
+        return std::make_unique<FrontierEngine>(rule);
+    if (name == "blocked")
+        return std::make_unique<TemporalBlockEngine>(rule);
+
+    throw std::invalid_argument("Unknown Life engine: " + name);
+}
+
 // --------------------------------------------------------------
 // Constructor:
 // Calls the base CellularAutomaton(r, c) to set up grid size,
+// picks the fastest byte engine this CPU supports,
 // then initializes the grid with a random pattern.
 // --------------------------------------------------------------
 ConwayLife::ConwayLife(int r, int c)
-    : CellularAutomaton(r, c)  // delegate grid creation to base class
+    : CellularAutomaton(r, c),  // delegate grid creation to base class
+      engine(std::make_unique<SimdEngine>()),
+      back(cells.size(), 0)
 {
     randomize(0.25);  // 25% initial density
 }
@@ -32,28 +187,208 @@ ConwayLife::ConwayLife(int r, int c)
 //   3. All other live cells die; all other dead cells stay dead.
 //
 // Implementation:
-//   - Create a separate "next" grid so updates do not interfere.
+//   - Refresh the halo from the boundary policy (once per generation).
+//   - Write into the "back" buffer so updates do not interfere.
 //   - Use countNeighbors() inherited from CellularAutomaton.
+//   - Swap front and back buffers (no copy, no allocation).
 // --------------------------------------------------------------
 void ConwayLife::step() {
-    // Copy current grid so we can compute next generation safely
-    std::vector<std::vector<int>> next = grid;
+    if (engine || usesBands()) {
+        step(1);
+        return;
+    }
+
+    fillHalo();
+    stepRows(0, rows);
+    cells.swap(back);  // Commit new generation
+}
+
+// The countNeighbors() loop for rows [first, last) of the board.
+void ConwayLife::stepRows(int first, int last) {
+    for (int i = first; i < last; ++i) {
+        uint8_t* out = &back[(size_t)(i + halo) * stride + halo];
 
-    for (int i = 0; i < rows; ++i) {
         for (int j = 0; j < cols; ++j) {
             int n = countNeighbors(i, j);  // # of live neighbors
 
-            if (grid[i][j]) {
-                // Live cell: survives only with 2 or 3 neighbors
-                next[i][j] = (n == 2 || n == 3);
-            } else {
-                // Dead cell: birth occurs only with exactly 3 neighbors
-                next[i][j] = (n == 3);
-            }
+            // Live cell: survives only with 2 or 3 neighbors
+            // Dead cell: birth occurs only with exactly 3 neighbors
+            out[j] = rule.next(at(i, j), n);
+        }
+    }
+}
+
+// --------------------------------------------------------------
+// step(gens)
+// Advances 'gens' generations. Engines that keep their own
+// representation (e.g. bit-packed words) only convert back to
+// bytes once at the end, so large 'gens' values stay cheap.
+// --------------------------------------------------------------
+void ConwayLife::step(int gens) {
+    if (usesBands()) {
+        stepBands(gens);
+        return;
+    }
+    if (!engine) {
+        for (int g = 0; g < gens; g++) step();
+        return;
+    }
+
+    engine->run(cells, back, layout(), gens);
+}
+
+bool ConwayLife::usesBands() const {
+    return threads > 1 && rows > 1 && (!engine || engine->splitsIntoBands());
+}
+
+bool ConwayLife::needsBack() const {
+    return !engine || usesBands() || engine->needsScratch();
+}
+
+void ConwayLife::fitBack() {
+    if (!needsBack())
+        CellBuffer(back.get_allocator()).swap(back);  // release the memory, not just the size
+    else if (back.size() != cells.size())
+        back.assign(cells.size(), 0);
+}
+
+// --------------------------------------------------------------
+// stepBands(gens)
+// Each generation: refill the halo, let every band compute its
+// rows into 'back' (band b uses bandEngines[b]), wait for all of
+// them (ThreadPool::run returns), swap. Band b covers rows
+// bandStart(rows, b) .. bandStart(rows, b + 1); its GridView reads
+// the neighboring bands' edge rows as its halo.
+// --------------------------------------------------------------
+void ConwayLife::stepBands(int gens) {
+    ThreadPool& workers = bandPool();
+    if (engine && (int)bandEngines.size() != threads) {
+        bandEngines.clear();
+        for (int b = 0; b < threads; b++) bandEngines.push_back(makeLifeEngine(engine->name(), rule));
+    }
+
+    const size_t origin = (size_t)halo * stride + halo;
+    auto band = [this, origin](int b) {
+        int first = bandStart(rows, b, threads), last = bandStart(rows, b + 1, threads);
+        if (first == last)
+            return;
+        if (!engine) {
+            stepRows(first, last);
+            return;
         }
+        size_t offset = origin + (size_t)first * stride;
+        bandEngines[b]->step(GridView(cells.data() + offset, last - first, cols, stride), back.data() + offset);
+    };
+
+    for (int g = 0; g < gens; g++) {
+        fillHalo();
+        workers.run(band);
+        cells.swap(back);
     }
+}
 
-    grid = next;  // Commit new generation
+ThreadPool& ConwayLife::bandPool() {
+    if (!pool || pool->size() != threads) {
+        pool = std::make_unique<ThreadPool>(threads);
+        pool->pin(pinning);
+    }
+    return *pool;
+}
+
+// --------------------------------------------------------------
+// placeBuffers()
+// Allocate fresh 'memory' buffers without writing them, then let
+// every band copy its rows of the board into the new front buffer
+// and zero them in the new back buffer, so each page is first
+// touched by the thread that will step it. Band 0 also takes the
+// top halo rows, the last band the bottom ones.
+// --------------------------------------------------------------
+void ConwayLife::placeBuffers() {
+    CellBuffer front{GridAllocator<uint8_t>(memory)}, scratch{GridAllocator<uint8_t>(memory)};
+    front.resize(cells.size());  // default-initialized: nothing touched yet
+    scratch.resize(needsBack() ? cells.size() : 0);
+
+    int bands  = usesBands() ? threads : 1;
+    auto touch = [&](int b) {
+        int first   = b == 0 ? 0 : bandStart(rows, b, bands) + halo;
+        int last    = b == bands - 1 ? rows + 2 * halo : bandStart(rows, b + 1, bands) + halo;
+        size_t from = (size_t)first * stride, bytes = (size_t)(last - first) * stride;
+        std::memcpy(front.data() + from, cells.data() + from, bytes);
+        if (!scratch.empty())
+            std::memset(scratch.data() + from, 0, bytes);
+    };
+    if (bands > 1)
+        bandPool().run(touch);
+    else
+        touch(0);
+
+    cells.swap(front);
+    back.swap(scratch);
+    cellsChanged();
+}
+
+void ConwayLife::setMemory(GridMemory mode) {
+    memory = mode;
+    placeBuffers();
+}
+
+void ConwayLife::setPinning(CpuPinning policy) {
+    pinning = policy;
+    pool.reset();
+    if (memory == GridMemory::HugePages)
+        placeBuffers();
+}
+
+void ConwayLife::setThreads(int n) {
+    threads = std::max(1, n);
+    pool.reset();
+    bandEngines.clear();
+    if (engine)
+        engine->setThreads(threads);
+    fitBack();
+    if (memory == GridMemory::HugePages)
+        placeBuffers();
+}
+
+void ConwayLife::cellsChanged() {
+    if (engine)
+        engine->invalidate();
+}
+
+void ConwayLife::setEngine(const std::string& name) {
+    engine = makeLifeEngine(name, rule);
+    if (engine)
+        engine->setThreads(threads);
+    bandEngines.clear();
+    fitBack();
+    if (memory == GridMemory::HugePages)
+        placeBuffers();
+}
+
+void ConwayLife::setRule(const LifeRule& r) {
+    rule   = r;
+    engine = makeLifeEngine(engineName(), rule);
+    if (engine)
+        engine->setThreads(threads);
+    bandEngines.clear();
+    fitBack();
+}
+
+std::string ConwayLife::engineName() const {
+    return engine ? engine->name() : "scalar";
+}
+
+void ConwayLife::printStats(std::ostream& out) const {
+    out << "engine: " << engineName() << ", rule " << rule.toString();
+    if (usesBands())
+        out << ", " << threads << " row bands";
+    if (memory == GridMemory::HugePages)
+        out << ", huge-page buffers";
+    if (pinning != CpuPinning::None && usesBands())
+        out << ", workers pinned " << (pinning == CpuPinning::Compact ? "compact" : "spread");
+    out << "\n";
+    if (engine)
+        engine->printStats(out);
 }
 
 // --------------------------------------------------------------
@@ -62,8 +397,10 @@ void ConwayLife::step() {
 // Simple text-based visualization for terminal.
 // --------------------------------------------------------------
 void ConwayLife::display() const {
-    for (const auto& row : grid) {
-        for (int cell : row) std::cout << (cell ? "⬜" : "  ");
+    GridView grid = getGrid();
+
+    for (int r = 0; r < grid.size(); r++) {
+        for (uint8_t cell : grid[r]) std::cout << (cell ? "⬜" : "  ");
         std::cout << "\n";
     }
 }
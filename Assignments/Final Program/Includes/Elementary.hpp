@@ -0,0 +1,278 @@
+#pragma once
+
+#include "CellularAutomaton.hpp"
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// --------------------------------------------------------------
+// parseElementaryRule(text):
+// Wolfram rule number 0..255, written "30", "rule30" or "W30".
+// Throws std::invalid_argument for anything else.
+// --------------------------------------------------------------
+inline int parseElementaryRule(const std::string& text) {
+    std::string t;
+    for (char ch : text)
+        if (!std::isspace((unsigned char)ch))
+            t += (char)std::tolower((unsigned char)ch);
+
+    if (t.rfind("rule", 0) == 0)
+        t = t.substr(4);
+    else if (!t.empty() && t[0] == 'w')
+        t = t.substr(1);
+
+    if (t.empty() || t.size() > 3 || t.find_first_not_of("0123456789") != std::string::npos || std::stoi(t) > 255)
+        throw std::invalid_argument("Elementary rules are 0..255: " + text);
+    return std::stoi(t);
+}
+
+// --------------------------------------------------------------
+// elementaryWord<Rule>(l, c, r):
+// Next state of 64 cells at once. l / c / r hold the left
+// neighbor, the cell and the right neighbor of every bit; bit
+// (4l + 2c + r) of Rule is the new state (Wolfram's numbering).
+//
+// The rule is a 3-input multiplexer: each rule bit becomes an
+// all-ones or all-zeros constant, so for a fixed Rule the compiler
+// folds the tree to a short boolean expression (rule 30 becomes
+// l ^ (c | r), rule 90 l ^ r).
+// --------------------------------------------------------------
+template <int Rule>
+inline uint64_t elementaryWord(uint64_t l, uint64_t c, uint64_t r) {
+    constexpr uint64_t ONES = ~0ULL;
+    constexpr uint64_t b0 = (Rule >> 0) & 1 ? ONES : 0, b1 = (Rule >> 1) & 1 ? ONES : 0;
+    constexpr uint64_t b2 = (Rule >> 2) & 1 ? ONES : 0, b3 = (Rule >> 3) & 1 ? ONES : 0;
+    constexpr uint64_t b4 = (Rule >> 4) & 1 ? ONES : 0, b5 = (Rule >> 5) & 1 ? ONES : 0;
+    constexpr uint64_t b6 = (Rule >> 6) & 1 ? ONES : 0, b7 = (Rule >> 7) & 1 ? ONES : 0;
+
+    uint64_t lc00 = (b0 & ~r) | (b1 & r);
+    uint64_t lc01 = (b2 & ~r) | (b3 & r);
+    uint64_t lc10 = (b4 & ~r) | (b5 & r);
+    uint64_t lc11 = (b6 & ~r) | (b7 & r);
+    uint64_t l0   = (lc00 & ~c) | (lc01 & c);
+    uint64_t l1   = (lc10 & ~c) | (lc11 & c);
+    return (l0 & ~l) | (l1 & l);
+}
+
+// --------------------------------------------------------------
+// elementaryRow<Rule>:
+// One generation of a bit-packed line: cell i is bit i % 64 of
+// word i / 64, 'words' words, the last holding 'tailBits' (1..64)
+// cells. leftIn / rightIn are the cells just past either end
+// (from the boundary policy). Bits past the last cell stay 0.
+// --------------------------------------------------------------
+using ElementaryStep = void (*)(const uint64_t* cur, uint64_t* next, int words, int tailBits, uint64_t leftIn,
+                                uint64_t rightIn);
+
+template <int Rule>
+void elementaryRow(const uint64_t* cur, uint64_t* next, int words, int tailBits, uint64_t leftIn, uint64_t rightIn) {
+    const int last = words - 1;
+
+    // Word 0 takes its left neighbor from the boundary
+    uint64_t x    = cur[0];
+    uint64_t right = last > 0 ? cur[1] << 63 : rightIn << (tailBits - 1);
+    next[0]       = elementaryWord<Rule>((x << 1) | leftIn, x, (x >> 1) | right);
+
+    // Inner words: neighbors are the adjacent words' edge bits
+    for (int w = 1; w < last; w++) {
+        x       = cur[w];
+        next[w] = elementaryWord<Rule>((x << 1) | (cur[w - 1] >> 63), x, (x >> 1) | (cur[w + 1] << 63));
+    }
+
+    if (last > 0) {
+        x          = cur[last];
+        next[last] = elementaryWord<Rule>((x << 1) | (cur[last - 1] >> 63), x, (x >> 1) | (rightIn << (tailBits - 1)));
+    }
+    next[last] &= ~0ULL >> (64 - tailBits);
+}
+
+// All 256 instances, indexed by rule number.
+template <size_t... Rules>
+constexpr std::array<ElementaryStep, 256> elementaryTable(std::index_sequence<Rules...>) {
+    return {{&elementaryRow<(int)Rules>...}};
+}
+
+inline ElementaryStep elementaryKernel(int rule) {
+    static constexpr std::array<ElementaryStep, 256> table = elementaryTable(std::make_index_sequence<256>());
+    return table[rule & 255];
+}
+
+// --------------------------------------------------------------
+// Elementary:
+// A Wolfram elementary (1D, radius 1) automaton, rules 0..255.
+// The line is 'cols' cells packed 64 per word (elementaryRow); the
+// base-class grid shows its space-time diagram: one row per
+// generation, newest at the bottom, scrolling up once full.
+//
+// Edits made through the grid (mouse, randomize, clear) change the
+// newest row, which is copied back into the line before the next
+// generation. The boundary policy supplies the cells past either
+// end of the line (toroidal = a ring).
+// --------------------------------------------------------------
+class Elementary : public CellularAutomaton {
+   private:
+    int rule;
+    ElementaryStep kernel;
+    int words, tailBits;
+    std::vector<uint64_t> line, back;
+    uint64_t generation = 0;
+    int filled          = 0;  // diagram rows in use
+    bool edited         = false;
+
+    void cellsChanged() override {
+        edited = true;
+    }
+
+    int newestRow() const {
+        return filled > 0 ? filled - 1 : 0;
+    }
+
+    bool bit(const std::vector<uint64_t>& bits, int c) const {
+        return (bits[c >> 6] >> (c & 63)) & 1;
+    }
+
+    // Cell just past the left (index -1) or right (index cols) end.
+    uint64_t edgeCell(int index) const {
+        int source = haloSource(index, cols, boundary);
+        return source < 0 ? (boundary == Boundary::Alive) : bit(line, source);
+    }
+
+    // Copy the newest diagram row into the line.
+    void importEdits() {
+        if (!edited)
+            return;
+        edited = false;
+        if (filled == 0)
+            filled = 1;
+
+        std::fill(line.begin(), line.end(), 0);
+        for (int c = 0; c < cols; c++)
+            if (at(newestRow(), c))
+                line[c >> 6] |= 1ULL << (c & 63);
+    }
+
+    // Add the line as the newest diagram row, scrolling if full.
+    void appendRow() {
+        if (filled == rows)
+            std::memmove(&at(0, 0), &at(1, 0), (size_t)(rows - 1) * stride);
+        else
+            filled++;
+
+        uint8_t* out = &at(filled - 1, 0);
+        for (int c = 0; c < cols; c++) out[c] = bit(line, c);
+    }
+
+   public:
+    // 'r' generations shown, 'c' cells wide; starts from one live
+    // cell in the middle.
+    Elementary(int r, int c, int wolframRule = 30)
+        : CellularAutomaton(r, c), words((c + 63) / 64), tailBits(c - 64 * ((c + 63) / 64 - 1)), line(words, 0), back(words, 0) {
+        setRule(wolframRule);
+        setLineCell(c / 2, 1);
+    }
+
+    // Throws std::invalid_argument outside 0..255.
+    void setRule(int wolframRule) {
+        if (wolframRule < 0 || wolframRule > 255)
+            throw std::invalid_argument("Elementary rules are 0..255: " + std::to_string(wolframRule));
+        rule   = wolframRule;
+        kernel = elementaryKernel(rule);
+    }
+    int getRule() const {
+        return rule;
+    }
+
+    // ----------------------------------------------------------
+    // The current line (generation getGeneration()).
+    // setLineCell restarts the diagram from this line.
+    // ----------------------------------------------------------
+    bool getLineCell(int c) const {
+        return bit(line, c);
+    }
+    void setLineCell(int c, bool alive) {
+        importEdits();
+        uint64_t mask = 1ULL << (c & 63);
+        line[c >> 6]  = alive ? (line[c >> 6] | mask) : (line[c >> 6] & ~mask);
+
+        std::memset(cells.data(), 0, cells.size());
+        filled = 0;
+        appendRow();
+    }
+    const std::vector<uint64_t>& lineWords() const {
+        return line;
+    }
+
+    uint64_t getGeneration() const {
+        return generation;
+    }
+
+    // Advance the line only (no diagram row).
+    void advance() {
+        importEdits();
+        kernel(line.data(), back.data(), words, tailBits, edgeCell(-1), edgeCell(cols));
+        line.swap(back);
+        generation++;
+    }
+
+    void step() override {
+        advance();
+        appendRow();
+    }
+
+    // Several generations; only the last 'rows' reach the diagram.
+    void step(int gens) override {
+        int shown = std::min(gens, rows);
+        for (int g = 0; g < gens - shown; g++) advance();
+        for (int g = 0; g < shown; g++) step();
+    }
+
+    // ----------------------------------------------------------
+    // writePBM(out, gens): stream the space-time diagram of the
+    // next 'gens' generations (plus the current line) to 'out' as
+    // a binary PBM image, one row at a time, without SDL or the
+    // diagram grid. Advances the automaton by 'gens'.
+    // ----------------------------------------------------------
+    void writePBM(std::ostream& out, int gens) {
+        importEdits();
+        out << "P4\n" << cols << " " << gens + 1 << "\n";
+
+        std::vector<char> row((cols + 7) / 8);
+        for (int g = 0; g <= gens; g++) {
+            if (g > 0)
+                advance();
+
+            // PBM packs 8 pixels per byte, leftmost in the high bit; 1 = black
+            for (size_t b = 0; b < row.size(); b++) {
+                uint8_t bits = (uint8_t)(line[b >> 3] >> ((b & 7) * 8));
+                uint8_t flipped = 0;
+                for (int i = 0; i < 8; i++) flipped |= ((bits >> i) & 1) << (7 - i);
+                row[b] = (char)flipped;
+            }
+            out.write(row.data(), (std::streamsize)row.size());
+        }
+    }
+
+    // Newest row last: '#' alive
+    void display() const override {
+        GridView grid = getGrid();
+
+        for (int r = 0; r < filled; r++) {
+            for (uint8_t cell : grid[r]) std::cout << (cell ? '#' : ' ');
+            std::cout << "\n";
+        }
+    }
+
+    void printStats(std::ostream& out) const override {
+        uint64_t population = 0;
+        for (uint64_t w : line) population += __builtin_popcountll(w);
+
+        out << "elementary: rule " << rule << ", generation " << generation << ", width " << cols << " (" << words
+            << " words), population " << population << "\n";
+    }
+};
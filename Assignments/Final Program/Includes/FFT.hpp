@@ -0,0 +1,227 @@
+#pragma once
+
+#include "Parallel.hpp"
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+using Complex = std::complex<float>;
+
+inline bool isPowerOfTwo(int n) {
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+inline int nextPowerOfTwo(int n) {
+    int p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+// --------------------------------------------------------------
+// FFT:
+// In-place iterative radix-2 complex FFT of one fixed size (a
+// power of two). Twiddles and the bit-reversal order are computed
+// once in the constructor (in double precision).
+//
+//   transform(data, false)  X[k] = sum x[m] e^(-2 pi i k m / n)
+//   transform(data, true)   the same with e^(+...), unscaled
+//
+// Products are written out by hand: std::complex<float>
+// multiplication checks for NaN/inf on every call.
+// --------------------------------------------------------------
+class FFT {
+   private:
+    int n;
+    std::vector<int> reversed;   // bit-reversed index of each position
+    std::vector<Complex> twiddle;  // e^(-2 pi i k / n), k < n/2
+
+   public:
+    explicit FFT(int size) : n(size), reversed(size), twiddle(size / 2) {
+        if (!isPowerOfTwo(size))
+            throw std::invalid_argument("FFT size must be a power of two: " + std::to_string(size));
+
+        int bits = 0;
+        while ((1 << bits) < n) bits++;
+        for (int i = 0; i < n; i++) {
+            int r = 0;
+            for (int b = 0; b < bits; b++) r |= ((i >> b) & 1) << (bits - 1 - b);
+            reversed[i] = r;
+        }
+        for (int k = 0; k < n / 2; k++) {
+            double angle = -2.0 * M_PI * k / n;
+            twiddle[k]   = Complex((float)std::cos(angle), (float)std::sin(angle));
+        }
+    }
+
+    int size() const {
+        return n;
+    }
+
+    void transform(Complex* data, bool inverse) const {
+        for (int i = 0; i < n; i++)
+            if (i < reversed[i])
+                std::swap(data[i], data[reversed[i]]);
+
+        const float sign = inverse ? -1.0f : 1.0f;
+        for (int len = 2; len <= n; len <<= 1) {
+            int half = len / 2, step = n / len;
+            for (int start = 0; start < n; start += len) {
+                Complex* a = data + start;
+                Complex* b = a + half;
+                for (int j = 0; j < half; j++) {
+                    float wr = twiddle[j * step].real(), wi = sign * twiddle[j * step].imag();
+                    float vr = b[j].real() * wr - b[j].imag() * wi;
+                    float vi = b[j].real() * wi + b[j].imag() * wr;
+                    float ur = a[j].real(), ui = a[j].imag();
+                    a[j]     = Complex(ur + vr, ui + vi);
+                    b[j]     = Complex(ur - vr, ui - vi);
+                }
+            }
+        }
+    }
+};
+
+// --------------------------------------------------------------
+// RealFFT2D:
+// 2D FFT of a real rows x cols field (both powers of two). A real
+// field's spectrum is conjugate-symmetric, so only the first
+// cols/2 + 1 columns are kept ("real-to-complex").
+//
+//   forward: each row is packed as cols/2 complex numbers
+//            (even + i*odd samples), transformed at half length
+//            and untangled into cols/2 + 1 bins; then every
+//            spectrum column gets a complex FFT
+//   inverse: the same steps backwards, scaled so that
+//            inverse(forward(x)) == x
+//
+// Rows are split across the bands of a ThreadPool for the row
+// pass and columns for the column pass. Columns are processed 8
+// at a time, so each gathered cache line is used in full, through
+// a scratch block per band that is kept between calls.
+// --------------------------------------------------------------
+class RealFFT2D {
+   private:
+    int rows, cols, half;
+    FFT rowFFT;                   // length cols/2
+    FFT colFFT;                   // length rows
+    std::vector<Complex> untangle;  // e^(-2 pi i k / cols), k <= cols/2
+    std::vector<Complex> scratch;   // BLOCK x rows per band, for columns()
+
+    static constexpr int BLOCK = 8;  // columns transformed together
+
+    static Complex mul(Complex a, Complex b) {
+        return Complex(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+    }
+
+    // Row spectrum X[0..cols/2] from the half-length FFT Z[0..cols/2-1] (in place).
+    void untangleRow(Complex* z) const {
+        const int m = cols / 2;
+        Complex z0  = z[0];
+        z[0]        = Complex(z0.real() + z0.imag(), 0.0f);
+        z[m]        = Complex(z0.real() - z0.imag(), 0.0f);
+
+        for (int k = 1; k <= m / 2; k++) {
+            int j      = m - k;
+            Complex zk = z[k], zj = z[j];
+            Complex even = (zk + std::conj(zj)) * 0.5f;  // spectrum of the even samples
+            Complex diff = (zk - std::conj(zj)) * 0.5f;
+            Complex odd(diff.imag(), -diff.real());      // diff / i: spectrum of the odd samples
+            z[k] = even + mul(untangle[k], odd);
+            z[j] = std::conj(even) + mul(untangle[j], std::conj(odd));
+        }
+    }
+
+    // Inverse of untangleRow: X[0..cols/2] -> Z[0..cols/2-1].
+    void tangleRow(Complex* x) const {
+        const int m = cols / 2;
+        for (int k = 0; k <= m / 2; k++) {
+            int j      = m - k;
+            Complex xk = x[k], xj = x[j];
+            Complex even  = (xk + std::conj(xj)) * 0.5f;
+            Complex oddK  = mul((xk - std::conj(xj)) * 0.5f, std::conj(untangle[k]));
+            x[k]          = even + Complex(-oddK.imag(), oddK.real());  // even + i*odd
+            if (j != k && j != m) {
+                Complex oddJ = mul((xj - std::conj(xk)) * 0.5f, std::conj(untangle[j]));
+                x[j]         = std::conj(even) + Complex(-oddJ.imag(), oddJ.real());
+            }
+        }
+    }
+
+    // Complex FFT down spectrum columns [first, last), using
+    // 'block' (BLOCK x rows).
+    void columns(Complex* spectrum, int first, int last, bool inverse, Complex* block) const {
+        for (int c = first; c < last; c += BLOCK) {
+            int width = std::min(BLOCK, last - c);
+            for (int r = 0; r < rows; r++)
+                for (int t = 0; t < width; t++) block[(size_t)t * rows + r] = spectrum[(size_t)r * half + c + t];
+            for (int t = 0; t < width; t++) colFFT.transform(&block[(size_t)t * rows], inverse);
+            for (int r = 0; r < rows; r++)
+                for (int t = 0; t < width; t++) spectrum[(size_t)r * half + c + t] = block[(size_t)t * rows + r];
+        }
+    }
+
+   public:
+    RealFFT2D(int r, int c) : rows(r), cols(c), half(c / 2 + 1), rowFFT(std::max(1, c / 2)), colFFT(r), untangle(c / 2 + 1) {
+        if (!isPowerOfTwo(c) || c < 2)
+            throw std::invalid_argument("RealFFT2D columns must be a power of two >= 2");
+        for (int k = 0; k <= c / 2; k++) {
+            double angle = -2.0 * M_PI * k / c;
+            untangle[k]  = Complex((float)std::cos(angle), (float)std::sin(angle));
+        }
+    }
+
+    int rowCount() const {
+        return rows;
+    }
+    int colCount() const {
+        return cols;
+    }
+    // Complex numbers per spectrum row (cols/2 + 1).
+    int spectrumCols() const {
+        return half;
+    }
+
+    // Column pass over the pool's bands, each with its own scratch.
+    void columnBands(Complex* spectrum, bool inverse, ThreadPool& pool) {
+        const int bands = pool.size();
+        scratch.resize((size_t)bands * BLOCK * rows);  // only grows when the pool does
+        pool.run([&](int band) {
+            int first = bandStart(half, band, bands), last = bandStart(half, band + 1, bands);
+            columns(spectrum, first, last, inverse, &scratch[(size_t)band * BLOCK * rows]);
+        });
+    }
+
+    // 'in': rows x cols floats; 'out': rows x spectrumCols().
+    void forward(const float* in, Complex* out, ThreadPool& pool) {
+        pool.split(rows, [&](int first, int last) {
+            for (int r = first; r < last; r++) {
+                const float* x = in + (size_t)r * cols;
+                Complex* z     = out + (size_t)r * half;
+                for (int k = 0; k < cols / 2; k++) z[k] = Complex(x[2 * k], x[2 * k + 1]);
+                rowFFT.transform(z, false);
+                untangleRow(z);
+            }
+        });
+        columnBands(out, false, pool);
+    }
+
+    // 'spectrum' is overwritten; 'out' receives rows x cols floats.
+    void inverse(Complex* spectrum, float* out, ThreadPool& pool) {
+        const float scale = 2.0f / ((float)rows * cols);
+
+        columnBands(spectrum, true, pool);
+        pool.split(rows, [&](int first, int last) {
+            for (int r = first; r < last; r++) {
+                Complex* z = spectrum + (size_t)r * half;
+                float* x   = out + (size_t)r * cols;
+                tangleRow(z);
+                rowFFT.transform(z, true);
+                for (int k = 0; k < cols / 2; k++) {
+                    x[2 * k]     = z[k].real() * scale;
+                    x[2 * k + 1] = z[k].imag() * scale;
+                }
+            }
+        });
+    }
+};
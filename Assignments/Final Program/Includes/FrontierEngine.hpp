@@ -0,0 +1,155 @@
+#pragma once
+
+#include "LifeEngine.hpp"
+#include "SimdEngine.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// --------------------------------------------------------------
+// FrontierEngine:
+// Event-driven stepping for sparse, slowly changing boards.
+//
+// Only a cell that changed last generation, or a neighbor of one,
+// can change now. The engine keeps the list of cells that changed
+// ("the frontier") and evaluates just those cells and their 8
+// neighbors, so the work per generation follows the activity and
+// not the board size.
+//
+// Like ActiveTileEngine, cells that are not evaluated need no copy:
+// they did not change last generation, so the back buffer already
+// holds their current value.
+//
+// After an edit (invalidate()) the next generation scans the whole
+// board once to rebuild the frontier.
+// --------------------------------------------------------------
+class FrontierEngine : public LifeEngine {
+   private:
+    struct Cell {
+        int r, c;
+    };
+
+    int rows = 0, cols = 0;
+    std::vector<Cell> frontier;    // cells that changed last generation
+    std::vector<Cell> candidates;  // cells to evaluate this generation
+    std::vector<uint8_t> queued;   // per cell: already in 'candidates'?
+    bool stale = true;
+    Boundary boundary = Boundary::Dead;
+    RowRule rule;
+    LifeRowKernel kernel;
+
+    // Stats for the most recent generation
+    size_t evaluated = 0;
+
+    void resize(int r, int c) {
+        if (r == rows && c == cols)
+            return;
+        rows = r;
+        cols = c;
+        queued.assign((size_t)r * c, 0);
+        frontier.clear();
+        stale = true;
+    }
+
+    // Add (r, c) to the candidates, mapping positions past the edge
+    // through the boundary: a toroidal board wraps, while for the
+    // other policies an outside cell has no in-board cells reading it
+    // that are not already neighbors of the changed cell.
+    void queue(int r, int c) {
+        if (r < 0 || r >= rows || c < 0 || c >= cols) {
+            if (boundary != Boundary::Toroidal)
+                return;
+            r = wrapIndex(r, rows);
+            c = wrapIndex(c, cols);
+        }
+
+        uint8_t& mark = queued[(size_t)r * cols + c];
+        if (!mark) {
+            mark = 1;
+            candidates.push_back({r, c});
+        }
+    }
+
+    // Whole board with the row kernel; frontier = cells that changed.
+    void fullStep(const GridView& src, uint8_t* dst) {
+        frontier.clear();
+        for (int r = 0; r < rows; r++) {
+            const uint8_t* in = src[r].begin();
+            uint8_t* out      = dst + (ptrdiff_t)r * src.rowStride();
+
+            kernel(src[r - 1].begin(), in, src[r + 1].begin(), out, cols, rule);
+            for (int c = 0; c < cols; c++)
+                if (out[c] != in[c])
+                    frontier.push_back({r, c});
+        }
+        evaluated = (size_t)rows * cols;
+        stale     = false;
+    }
+
+   public:
+    explicit FrontierEngine(const LifeRule& r = LifeRule::conway())
+        : rule(makeRowRule(r)), kernel(lifeRowKernel(detectSimdLevel(), r)) {
+    }
+
+    const char* name() const override {
+        return "frontier";
+    }
+
+    void run(CellBuffer& cur, CellBuffer& next, const GridLayout& layout, int gens) override {
+        resize(layout.rows, layout.cols);
+        boundary = layout.boundary;
+        LifeEngine::run(cur, next, layout, gens);
+    }
+
+    void step(const GridView& src, uint8_t* dst) override {
+        resize(src.rowCount(), src.colCount());
+        if (stale) {
+            fullStep(src, dst);
+            return;
+        }
+
+        // Candidates: every changed cell and its neighbors, once each
+        candidates.clear();
+        for (const Cell& cell : frontier)
+            for (int dr = -1; dr <= 1; dr++)
+                for (int dc = -1; dc <= 1; dc++) queue(cell.r + dr, cell.c + dc);
+
+        // Evaluate them (the halo makes edge cells safe to read)
+        frontier.clear();
+        int stride = src.rowStride();
+        for (const Cell& cell : candidates) {
+            const uint8_t* up   = src[cell.r - 1].begin() + cell.c;
+            const uint8_t* mid  = src[cell.r].begin() + cell.c;
+            const uint8_t* down = src[cell.r + 1].begin() + cell.c;
+
+            int n = up[-1] + up[0] + up[1] + mid[-1] + mid[1] + down[-1] + down[0] + down[1];
+            uint8_t next = (rule.mask >> (9 * mid[0] + n)) & 1;
+
+            dst[(ptrdiff_t)cell.r * stride + cell.c] = next;
+            if (next != mid[0])
+                frontier.push_back(cell);
+
+            queued[(size_t)cell.r * cols + cell.c] = 0;
+        }
+        evaluated = candidates.size();
+    }
+
+    void invalidate() override {
+        LifeEngine::invalidate();
+        stale = true;
+    }
+
+    // Cells changed / evaluated in the most recent generation
+    size_t activeCells() const {
+        return frontier.size();
+    }
+    size_t evaluatedCells() const {
+        return evaluated;
+    }
+
+    void printStats(std::ostream& out) const override {
+        out << "frontier: " << frontier.size() << " cells changed, " << evaluated << " evaluated of "
+            << (size_t)rows * cols << "\n";
+    }
+};
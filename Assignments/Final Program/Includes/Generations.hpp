@@ -0,0 +1,326 @@
+#pragma once
+
+#include "CellularAutomaton.hpp"
+#include "LifeRule.hpp"
+#include "SimdEngine.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// --------------------------------------------------------------
+// GenerationsRule:
+// A Life-like rule where a live cell that does not survive fades
+// out through refractory ("dying") states before it is dead:
+//
+//   state 0            dead; born (-> 1) with n in 'life.birth'
+//   state 1            alive; stays 1 with n in 'life.survive',
+//                      otherwise starts dying (-> 2)
+//   state 2..states-1  dying; moves to the next state, and the
+//                      last one back to 0
+//
+// Only state-1 cells count as neighbors. Written B2/S/C3 (Brian's
+// Brain) where C is the total number of states; with C2 it is an
+// ordinary Life-like rule.
+// --------------------------------------------------------------
+struct GenerationsRule {
+    LifeRule life;
+    int states;  // 2..255
+
+    // Brian's Brain: B2/S/C3
+    static GenerationsRule briansBrain() {
+        return {LifeRule::seeds(), 3};
+    }
+
+    // Star Wars: B2/S345/C4
+    static GenerationsRule starWars() {
+        return {LifeRule{1u << 2, (1u << 3) | (1u << 4) | (1u << 5)}, 4};
+    }
+
+    // "B2/S345/C4"
+    std::string toString() const {
+        return life.toString() + "/C" + std::to_string(states);
+    }
+
+    // ----------------------------------------------------------
+    // parse(text):
+    // Accepts "B2/S345/C4" (B, S and C in any order), the older
+    // "345/2/4" survive/birth/states form, and the names
+    // briansbrain and starwars.
+    // Throws std::invalid_argument for anything else.
+    // ----------------------------------------------------------
+    static GenerationsRule parse(const std::string& text) {
+        std::string t;
+        for (char ch : text)
+            if (!std::isspace((unsigned char)ch))
+                t += (char)std::tolower((unsigned char)ch);
+
+        if (t == "briansbrain" || t == "brian'sbrain")
+            return briansBrain();
+        if (t == "starwars")
+            return starWars();
+
+        std::vector<std::string> parts(1);
+        for (char ch : t) {
+            if (ch == '/')
+                parts.emplace_back();
+            else
+                parts.back() += ch;
+        }
+        if (parts.size() != 3)
+            throw std::invalid_argument("Unknown Generations rule: " + text);
+
+        std::string birth, survive, count;
+        bool letters = false;
+        for (const std::string& part : parts) {
+            char tag = part.empty() ? 0 : part[0];
+            if (tag == 'b' || tag == 's' || tag == 'c' || tag == 'g') {
+                letters = true;
+                (tag == 'b' ? birth : tag == 's' ? survive : count) = part;
+            }
+        }
+        if (!letters) {
+            survive = parts[0];
+            birth   = parts[1];
+            count   = parts[2];
+        } else {
+            if (count.empty())
+                throw std::invalid_argument("Unknown Generations rule: " + text);
+            count = count.substr(1);
+        }
+
+        GenerationsRule rule;
+        rule.life = letters ? LifeRule::parse(birth + "/" + survive) : LifeRule::parse(survive + "/" + birth);
+
+        if (count.empty() || count.size() > 3 || count.find_first_not_of("0123456789") != std::string::npos)
+            throw std::invalid_argument("Unknown Generations rule: " + text);
+        rule.states = std::stoi(count);
+        if (rule.states < 2 || rule.states > 255)
+            throw std::invalid_argument("Generations rules need 2..255 states: " + text);
+        return rule;
+    }
+};
+
+// --------------------------------------------------------------
+// Generations row kernels:
+// One output row from three input rows (readable from -1 to n,
+// like the Life row kernels). In a single pass each kernel counts
+// the state-1 neighbors, applies birth/survival, and advances the
+// dying states:
+//
+//     next = self == 0                   ? birth[count]
+//          : self == 1 && survive[count] ? 1
+//          : (self + 1) % states
+//
+// The SIMD versions add up "neighbor == 1" compare masks (each is
+// -1 or 0, so subtracting counts them), then pick the result with
+// masks instead of branches.
+// --------------------------------------------------------------
+struct GenerationsRowRule {
+    RowRule life;
+    uint8_t states;
+};
+
+using GenerationsRowKernel = void (*)(const uint8_t* up, const uint8_t* mid, const uint8_t* down, uint8_t* out,
+                                      int n, const GenerationsRowRule& rule);
+
+inline void generationsRowScalar(const uint8_t* up, const uint8_t* mid, const uint8_t* down, uint8_t* out, int n,
+                                 const GenerationsRowRule& rule) {
+    for (int c = 0; c < n; c++) {
+        int count = (up[c - 1] == 1) + (up[c] == 1) + (up[c + 1] == 1) + (mid[c - 1] == 1) + (mid[c + 1] == 1) +
+                    (down[c - 1] == 1) + (down[c] == 1) + (down[c + 1] == 1);
+        int self = mid[c];
+
+        if (self == 0)
+            out[c] = rule.life.birth[count];
+        else if (self == 1 && rule.life.survive[count])
+            out[c] = 1;
+        else
+            out[c] = self + 1 == rule.states ? 0 : self + 1;
+    }
+}
+
+#ifdef LIFE_X86_SIMD
+// The 16-cell blocks of a row with a 'Keys'-compare rule (see
+// RuleKeysSSE2); returns the first column not done.
+template <int Keys>
+__attribute__((target("sse2"))) inline int generationsRowSSE2Blocks(const uint8_t* up, const uint8_t* mid,
+                                                                    const uint8_t* down, uint8_t* out, int n,
+                                                                    const GenerationsRowRule& rule) {
+    const __m128i zero   = _mm_setzero_si128();
+    const __m128i one    = _mm_set1_epi8(1);
+    const __m128i states = _mm_set1_epi8((char)rule.states);
+    const RuleKeysSSE2 keys(rule.life);
+    int c                = 0;
+
+    for (; c + 16 <= n; c += 16) {
+        __m128i count = zero;
+        for (const uint8_t* p : {up + c - 1, up + c, up + c + 1, mid + c - 1, mid + c + 1, down + c - 1, down + c,
+                                 down + c + 1})
+            count = _mm_sub_epi8(count, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), one));
+
+        __m128i self  = _mm_loadu_si128((const __m128i*)(mid + c));
+        __m128i dead  = _mm_cmpeq_epi8(self, zero);
+        __m128i alive = _mm_cmpeq_epi8(self, one);
+        __m128i hit   = keys.next<Keys>(count, alive);  // survival for state 1, birth otherwise
+        __m128i keep  = _mm_and_si128(alive, hit);
+        __m128i born  = _mm_and_si128(hit, one);
+        __m128i inc   = _mm_add_epi8(self, one);
+        __m128i aged  = _mm_andnot_si128(_mm_cmpeq_epi8(inc, states), inc);
+
+        __m128i living = _mm_or_si128(_mm_and_si128(keep, one), _mm_andnot_si128(keep, aged));
+        __m128i next   = _mm_or_si128(_mm_and_si128(dead, born), _mm_andnot_si128(dead, living));
+        _mm_storeu_si128((__m128i*)(out + c), next);
+    }
+    return c;
+}
+
+__attribute__((target("sse2"))) inline void generationsRowSSE2(const uint8_t* up, const uint8_t* mid,
+                                                               const uint8_t* down, uint8_t* out, int n,
+                                                               const GenerationsRowRule& rule) {
+    int c = withKeyCount(rule.life.keyCount, [&](auto keys) {
+        return generationsRowSSE2Blocks<decltype(keys)::value>(up, mid, down, out, n, rule);
+    });
+    generationsRowScalar(up + c, mid + c, down + c, out + c, n - c, rule);
+}
+
+__attribute__((target("avx2"))) inline void generationsRowAVX2(const uint8_t* up, const uint8_t* mid,
+                                                               const uint8_t* down, uint8_t* out, int n,
+                                                               const GenerationsRowRule& rule) {
+    const __m256i zero    = _mm256_setzero_si256();
+    const __m256i one     = _mm256_set1_epi8(1);
+    const __m256i states  = _mm256_set1_epi8((char)rule.states);
+    const __m256i birth   = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)rule.life.birth));
+    const __m256i survive = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)rule.life.survive));
+    int c                 = 0;
+
+    for (; c + 32 <= n; c += 32) {
+        __m256i count = zero;
+        for (const uint8_t* p : {up + c - 1, up + c, up + c + 1, mid + c - 1, mid + c + 1, down + c - 1, down + c,
+                                 down + c + 1})
+            count = _mm256_sub_epi8(count, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)p), one));
+
+        __m256i self = _mm256_loadu_si256((const __m256i*)(mid + c));
+        __m256i keep = _mm256_and_si256(_mm256_cmpeq_epi8(self, one),
+                                        _mm256_cmpeq_epi8(_mm256_shuffle_epi8(survive, count), one));
+        __m256i inc  = _mm256_add_epi8(self, one);
+        __m256i aged = _mm256_andnot_si256(_mm256_cmpeq_epi8(inc, states), inc);
+
+        __m256i next = _mm256_blendv_epi8(aged, one, keep);
+        next         = _mm256_blendv_epi8(next, _mm256_shuffle_epi8(birth, count), _mm256_cmpeq_epi8(self, zero));
+        _mm256_storeu_si256((__m256i*)(out + c), next);
+    }
+
+    generationsRowSSE2(up + c, mid + c, down + c, out + c, n - c, rule);
+}
+#endif
+
+// Kernel for a given level (must be supported by this CPU).
+inline GenerationsRowKernel generationsRowKernel(SimdLevel level) {
+#ifdef LIFE_X86_SIMD
+    if (level == SimdLevel::AVX2)
+        return generationsRowAVX2;
+    if (level == SimdLevel::SSE2)
+        return generationsRowSSE2;
+#endif
+    (void)level;
+    return generationsRowScalar;
+}
+
+// --------------------------------------------------------------
+// Generations:
+// CellularAutomaton for Generations rules (Brian's Brain, Star
+// Wars, ...). Cells hold their state 0..states-1 in the byte grid,
+// so renderers color them through a palette (see stateCount()).
+//
+// Like ConwayLife it writes into a back buffer and swaps, and uses
+// the best SIMD kernel the CPU supports.
+// --------------------------------------------------------------
+class Generations : public CellularAutomaton {
+   private:
+    GenerationsRule rule;
+    GenerationsRowRule rowRule;
+    SimdLevel level;
+    GenerationsRowKernel kernel;
+    CellBuffer back;
+
+   public:
+    Generations(int r, int c, const GenerationsRule& g = GenerationsRule::briansBrain())
+        : CellularAutomaton(r, c), level(detectSimdLevel()), kernel(generationsRowKernel(level)), back(cells.size(), 0) {
+        setRule(g);
+        randomize(0.25);  // 25% of cells start alive (state 1)
+    }
+
+    // Cells in states the new rule does not have become dead.
+    void setRule(const GenerationsRule& g) {
+        if (g.states < 2 || g.states > 255)
+            throw std::invalid_argument("Generations rules need 2..255 states");
+        rule    = g;
+        rowRule = {makeRowRule(g.life), (uint8_t)g.states};
+
+        for (int r = 0; r < rows; r++)
+            for (int c = 0; c < cols; c++)
+                if (at(r, c) >= g.states)
+                    at(r, c) = 0;
+    }
+    const GenerationsRule& getRule() const {
+        return rule;
+    }
+
+    // Force an instruction set ("scalar", "sse2", "avx2" kernels).
+    // Throws std::invalid_argument if the CPU does not support it.
+    void setSimdLevel(SimdLevel wanted) {
+        if ((int)wanted > (int)detectSimdLevel())
+            throw std::invalid_argument(std::string("CPU does not support ") + simdLevelName(wanted));
+        level  = wanted;
+        kernel = generationsRowKernel(wanted);
+    }
+    SimdLevel getSimdLevel() const {
+        return level;
+    }
+
+    int stateCount() const override {
+        return rule.states;
+    }
+
+    // Values are clamped to 0..states-1: the kernels only age and
+    // wrap states the rule has.
+    void setCell(int r, int c, int value) override {
+        CellularAutomaton::setCell(r, c, std::clamp(value, 0, rule.states - 1));
+    }
+
+    using CellularAutomaton::step;  // step(gens) loops over step()
+
+    void step() override {
+        fillHalo();
+
+        for (int r = 0; r < rows; r++)
+            kernel(&at(r - 1, 0), &at(r, 0), &at(r + 1, 0), &back[(size_t)(r + halo) * stride + halo], cols, rowRule);
+
+        cells.swap(back);
+    }
+
+    // '#' alive, '+' dying, ' ' dead
+    void display() const override {
+        GridView grid = getGrid();
+
+        for (int r = 0; r < grid.size(); r++) {
+            for (uint8_t cell : grid[r]) std::cout << (cell == 1 ? '#' : cell ? '+' : ' ');
+            std::cout << "\n";
+        }
+    }
+
+    void printStats(std::ostream& out) const override {
+        std::vector<long> census(rule.states, 0);
+        GridView grid = getGrid();
+        for (int r = 0; r < grid.size(); r++)
+            for (uint8_t cell : grid[r]) census[std::min<int>(cell, rule.states - 1)]++;
+
+        out << "generations: rule " << rule.toString() << ", kernel " << simdLevelName(level) << ", cells per state";
+        for (long n : census) out << " " << n;
+        out << "\n";
+    }
+};
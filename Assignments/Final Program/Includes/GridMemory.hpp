@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#define LIFE_HUGE_PAGES 1
+#endif
+
+// --------------------------------------------------------------
+// GridMemory: where a board's cell buffers come from.
+//
+//   Heap       operator new, like any std::vector
+//   HugePages  anonymous mmap() rounded up to 2 MB and marked
+//              MADV_HUGEPAGE, so the kernel backs it with
+//              transparent huge pages (one TLB entry per 2 MB
+//              instead of per 4 KB). Heap on non-Linux systems.
+//
+// mmap'd pages only get a physical home (and NUMA node) when
+// first written, so the model can have each worker thread touch
+// the rows it will step (see ConwayLife::setMemory).
+// --------------------------------------------------------------
+enum class GridMemory { Heap, HugePages };
+
+inline GridMemory parseGridMemory(const std::string& name) {
+    if (name == "heap")
+        return GridMemory::Heap;
+    if (name == "huge")
+        return GridMemory::HugePages;
+    throw std::invalid_argument("Unknown memory mode: " + name + " (heap or huge)");
+}
+
+inline const char* gridMemoryName(GridMemory m) {
+    return m == GridMemory::HugePages ? "huge" : "heap";
+}
+
+// --------------------------------------------------------------
+// GridAllocator<T>:
+// std::vector allocator for the cell buffers, using 'mode'.
+//
+// construct() without arguments default-initializes, so
+// resize(n) leaves new elements unwritten (their pages untouched)
+// and the caller decides which thread writes them first.
+// vector(n, value) still writes every element.
+//
+// Huge-page buffers do not start on the 2 MB boundary mmap()
+// gives them: each is shifted by a different multiple of one page
+// plus one cache line. Two buffers both starting on 2 MB
+// boundaries put row r of the front and back buffers in the same
+// cache sets, which made stepping about twice as slow.
+// --------------------------------------------------------------
+template <typename T>
+class GridAllocator {
+   public:
+    using value_type = T;
+
+    // Buffers swap and move together with their allocator, so a
+    // huge-page buffer is always unmapped by munmap().
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    static constexpr size_t HUGE_PAGE = 2 << 20;
+    static constexpr size_t COLOR     = 4096 + 64;  // shift per buffer
+    static constexpr int COLORS       = 16;
+
+    GridMemory mode = GridMemory::Heap;
+
+    GridAllocator() = default;
+    explicit GridAllocator(GridMemory m) : mode(m) {
+    }
+    template <typename U>
+    GridAllocator(const GridAllocator<U>& other) : mode(other.mode) {
+    }
+
+    T* allocate(size_t n) {
+#ifdef LIFE_HUGE_PAGES
+        if (mode == GridMemory::HugePages) {
+            static std::atomic<int> nextColor{0};
+            size_t shift = (size_t)(nextColor++ % COLORS) * COLOR;
+            size_t bytes = mappedBytes(n, shift);
+
+            void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED)
+                throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+            madvise(p, bytes, MADV_HUGEPAGE);  // only a hint: 4 KB pages if refused
+#endif
+            return reinterpret_cast<T*>(static_cast<char*>(p) + shift);
+        }
+#endif
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+#ifdef LIFE_HUGE_PAGES
+        if (mode == GridMemory::HugePages) {
+            // The cache-line part of the shift gives back the color
+            size_t shift = (reinterpret_cast<uintptr_t>(p) % 4096) / 64 * COLOR;
+            munmap(reinterpret_cast<char*>(p) - shift, mappedBytes(n, shift));
+            return;
+        }
+#endif
+        (void)n;
+        ::operator delete(p);
+    }
+
+    template <typename U>
+    void construct(U* p) {
+        ::new ((void*)p) U;
+    }
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        ::new ((void*)p) U(std::forward<Args>(args)...);
+    }
+
+    static size_t mappedBytes(size_t n, size_t shift) {
+        return (shift + n * sizeof(T) + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE;
+    }
+
+    template <typename U>
+    bool operator==(const GridAllocator<U>& other) const {
+        return mode == other.mode;
+    }
+    template <typename U>
+    bool operator!=(const GridAllocator<U>& other) const {
+        return mode != other.mode;
+    }
+};
+
+// Halo-padded byte grid of a CellularAutomaton (and its back buffer).
+using CellBuffer = std::vector<uint8_t, GridAllocator<uint8_t>>;
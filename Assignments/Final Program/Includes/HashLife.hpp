@@ -0,0 +1,508 @@
+#pragma once
+
+#include "LifeRule.hpp"
+#include "UnboundedAutomaton.hpp"
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+// --------------------------------------------------------------
+// HashLife:
+// Gosper's HashLife algorithm for running patterns out to millions
+// or billions of generations on an unbounded plane.
+//
+// The universe is a quadtree. A node of level L is a 2^L x 2^L
+// square made of four level L-1 children; level 0 nodes are single
+// cells. Nodes are "hash-consed": every distinct square exists only
+// once, so repeated structure (empty space, guns, glider streams)
+// is stored once no matter how often it appears.
+//
+// Each node memoizes its RESULT: the center 2^(L-1) square after
+// 2^j generations. Because the same nodes keep reappearing, most
+// RESULTs are found in the cache, and stepPow2(k) advances 2^k
+// generations in roughly the time a few normal steps would take.
+//
+// The base-class grid is a viewport onto the universe (see
+// UnboundedAutomaton); edits are copied into the tree before the
+// next step.
+//
+// Memory: when the node table grows past the limit (setMemoryLimit),
+// nodes no longer reachable from the current pattern are garbage
+// collected between steps.
+// --------------------------------------------------------------
+class HashLife : public UnboundedAutomaton {
+   public:
+    using NodeId = uint32_t;
+
+    HashLife(int r, int c);
+
+    void step() override;           // one generation
+    void step(int gens) override;   // 'gens' generations
+    void printStats(std::ostream& out) const override;
+
+    // Advance 2^k generations in one HashLife step.
+    void stepPow2(int k);
+
+    // Advance any number of generations (one stepPow2 per set bit).
+    void advance(uint64_t gens);
+
+    uint8_t getUniverseCell(int64_t row, int64_t col) const override;
+    void setUniverseCell(int64_t row, int64_t col, uint8_t state) override;
+
+    uint64_t getGeneration() const {
+        return generation;
+    }
+    uint64_t getPopulation() const {
+        return nodes[root].population;
+    }
+    size_t nodeCount() const {
+        return liveNodes;
+    }
+
+    // Any Life-like rule except B0 rules, which would fill the
+    // infinite plane at once (throws std::invalid_argument).
+    // Flushes the RESULT cache, which belongs to the old rule.
+    void setRule(const LifeRule& r);
+    const LifeRule& getRule() const {
+        return rule;
+    }
+
+    // Cap on node-table memory; garbage collection keeps it below this.
+    void setMemoryLimit(size_t megabytes);
+
+    // Drop unreachable nodes now. With keepResults = false the RESULT
+    // cache is flushed too, which frees the most memory.
+    void collectGarbage(bool keepResults = true);
+
+   protected:
+    void drawRegion(int64_t top, int64_t left, int rowCount, int colCount, uint8_t* out, int outStride) const override;
+
+   private:
+    struct Node {
+        NodeId nw, ne, sw, se;  // children (unused for level 0)
+        NodeId result;          // memoized RESULT, or NONE
+        NodeId next;            // hash-chain link
+        uint64_t population;    // live cells in this square
+        uint8_t level;          // size is 2^level
+        int8_t resultStep;      // RESULT covers 2^resultStep generations
+        uint8_t mark;           // garbage-collection mark
+        uint8_t free;           // on the free list
+    };
+
+    static constexpr NodeId NONE = 0xFFFFFFFFu;
+
+    std::vector<Node> nodes;
+    std::vector<NodeId> freeList;
+    std::vector<NodeId> buckets;    // hash table heads
+    std::vector<NodeId> emptyNode;  // canonical empty square per level
+    size_t liveNodes = 0;
+    size_t maxNodes  = 0;
+
+    NodeId root;  // centered on universe cell (0, 0)
+    uint64_t generation = 0;
+    LifeRule rule       = LifeRule::conway();
+
+    // --- node table ---
+    static size_t hashChildren(NodeId a, NodeId b, NodeId c, NodeId d);
+    NodeId newNode(const Node& n);
+    NodeId join(NodeId nw, NodeId ne, NodeId sw, NodeId se);
+    NodeId empty(int level);
+    void rehash(size_t bucketCount);
+
+    // --- quadtree operations ---
+    NodeId expand(NodeId n);
+    NodeId centre(NodeId n);
+    NodeId horizontal(NodeId w, NodeId e);
+    NodeId vertical(NodeId n, NodeId s);
+    NodeId baseStep(NodeId n);
+    NodeId successor(NodeId n, int j);
+    bool innerQuarterHoldsAll(NodeId n) const;
+    void stepRoot(int k);
+
+    bool cellIn(NodeId n, int64_t row, int64_t col) const;  // relative to n's top-left
+    NodeId withCell(NodeId n, int64_t row, int64_t col, bool alive);
+    int64_t rootHalf() const {
+        return (int64_t)1 << (nodes[root].level - 1);
+    }
+
+    void draw(NodeId n, int64_t top, int64_t left, int64_t rTop, int64_t rLeft, int rCount, int cCount, uint8_t* out,
+              int outStride) const;
+    void mark(NodeId n, bool keepResults);
+};
+
+// --------------------------------------------------------------
+// Constructor: 'r' x 'c' viewport over an empty universe.
+// Nodes 0 and 1 are the dead and alive cells.
+// --------------------------------------------------------------
+HashLife::HashLife(int r, int c) : UnboundedAutomaton(r, c) {
+    setMemoryLimit(512);
+    rehash(1 << 16);
+
+    Node cell{NONE, NONE, NONE, NONE, NONE, NONE, 0, 0, -1, 0, 0};
+    newNode(cell);  // 0: dead
+    cell.population = 1;
+    newNode(cell);  // 1: alive
+
+    emptyNode.push_back(0);
+    root = empty(3);
+}
+
+// --------------------------------------------------------------
+// Node table
+// --------------------------------------------------------------
+size_t HashLife::hashChildren(NodeId a, NodeId b, NodeId c, NodeId d) {
+    uint64_t h = a;
+    h          = h * 0x9E3779B97F4A7C15ULL + b;
+    h          = h * 0x9E3779B97F4A7C15ULL + c;
+    h          = h * 0x9E3779B97F4A7C15ULL + d;
+    return (size_t)(h ^ (h >> 29));
+}
+
+HashLife::NodeId HashLife::newNode(const Node& n) {
+    NodeId id;
+    if (!freeList.empty()) {
+        id = freeList.back();
+        freeList.pop_back();
+        nodes[id] = n;
+    } else {
+        id = (NodeId)nodes.size();
+        nodes.push_back(n);
+    }
+    liveNodes++;
+    return id;
+}
+
+void HashLife::rehash(size_t bucketCount) {
+    buckets.assign(bucketCount, NONE);
+    for (NodeId id = 2; id < nodes.size(); id++) {
+        Node& n = nodes[id];
+        if (n.free)
+            continue;
+        size_t slot = hashChildren(n.nw, n.ne, n.sw, n.se) & (bucketCount - 1);
+        n.next      = buckets[slot];
+        buckets[slot] = id;
+    }
+}
+
+// --------------------------------------------------------------
+// join(nw, ne, sw, se):
+// The canonical node with these four children (created if new).
+// --------------------------------------------------------------
+HashLife::NodeId HashLife::join(NodeId nw, NodeId ne, NodeId sw, NodeId se) {
+    size_t slot = hashChildren(nw, ne, sw, se) & (buckets.size() - 1);
+
+    for (NodeId id = buckets[slot]; id != NONE; id = nodes[id].next) {
+        const Node& n = nodes[id];
+        if (n.nw == nw && n.ne == ne && n.sw == sw && n.se == se)
+            return id;
+    }
+
+    Node n{nw, ne, sw, se, NONE, buckets[slot], 0, (uint8_t)(nodes[nw].level + 1), -1, 0, 0};
+    n.population  = nodes[nw].population + nodes[ne].population + nodes[sw].population + nodes[se].population;
+    NodeId id     = newNode(n);
+    buckets[slot] = id;
+
+    if (liveNodes > buckets.size())
+        rehash(buckets.size() * 2);
+    return id;
+}
+
+HashLife::NodeId HashLife::empty(int level) {
+    while ((int)emptyNode.size() <= level) {
+        NodeId e = emptyNode.back();
+        emptyNode.push_back(join(e, e, e, e));
+    }
+    return emptyNode[level];
+}
+
+// --------------------------------------------------------------
+// Quadtree helpers (all return canonical nodes)
+// --------------------------------------------------------------
+
+// Same square, one level bigger, with 'n' in the middle.
+HashLife::NodeId HashLife::expand(NodeId id) {
+    Node n   = nodes[id];
+    NodeId e = empty(n.level - 1);
+    return join(join(e, e, e, n.nw), join(e, e, n.ne, e), join(e, n.sw, e, e), join(n.se, e, e, e));
+}
+
+// Middle half of 'n' (one level smaller).
+HashLife::NodeId HashLife::centre(NodeId id) {
+    Node n = nodes[id];
+    return join(nodes[n.nw].se, nodes[n.ne].sw, nodes[n.sw].ne, nodes[n.se].nw);
+}
+
+// Square straddling the edge between side-by-side nodes 'w' and 'e'.
+HashLife::NodeId HashLife::horizontal(NodeId w, NodeId e) {
+    Node a = nodes[w], b = nodes[e];
+    return join(a.ne, b.nw, a.se, b.sw);
+}
+
+// Square straddling the edge between stacked nodes 'n' and 's'.
+HashLife::NodeId HashLife::vertical(NodeId n, NodeId s) {
+    Node a = nodes[n], b = nodes[s];
+    return join(a.sw, a.se, b.nw, b.ne);
+}
+
+// --------------------------------------------------------------
+// baseStep(n): a 4x4 node -> its 2x2 center one generation later.
+// --------------------------------------------------------------
+HashLife::NodeId HashLife::baseStep(NodeId id) {
+    Node n       = nodes[id];
+    NodeId q[4]  = {n.nw, n.ne, n.sw, n.se};
+    int cell[4][4];
+
+    for (int k = 0; k < 4; k++) {
+        Node quad = nodes[q[k]];
+        int r0 = (k / 2) * 2, c0 = (k % 2) * 2;
+        cell[r0][c0]         = (int)quad.nw;
+        cell[r0][c0 + 1]     = (int)quad.ne;
+        cell[r0 + 1][c0]     = (int)quad.sw;
+        cell[r0 + 1][c0 + 1] = (int)quad.se;
+    }
+
+    NodeId next[4];
+    for (int k = 0; k < 4; k++) {
+        int r = 1 + k / 2, c = 1 + k % 2, neighbors = 0;
+        for (int dr = -1; dr <= 1; dr++)
+            for (int dc = -1; dc <= 1; dc++)
+                if (dr || dc)
+                    neighbors += cell[r + dr][c + dc];
+        next[k] = rule.next(cell[r][c], neighbors) ? 1 : 0;
+    }
+    return join(next[0], next[1], next[2], next[3]);
+}
+
+// --------------------------------------------------------------
+// successor(n, j):
+// RESULT of a level-L node: its center (level L-1) after 2^j
+// generations, for 0 <= j <= L-2.
+//
+// The node is cut into 9 overlapping level L-1 squares.
+//   j == L-2 (full speed): each square is advanced 2^(L-3)
+//     generations, regrouped into 4 squares, and advanced again.
+//   j <  L-2: the 9 squares are only re-centered, and the 4
+//     regrouped squares are advanced the full 2^j.
+// --------------------------------------------------------------
+HashLife::NodeId HashLife::successor(NodeId id, int j) {
+    Node n = nodes[id];
+
+    if (n.population == 0)
+        return empty(n.level - 1);
+    if (n.result != NONE && n.resultStep == j)
+        return n.result;
+
+    NodeId result;
+    if (n.level == 2) {
+        result = baseStep(id);
+    } else {
+        NodeId s[9] = {n.nw,          horizontal(n.nw, n.ne), n.ne,
+                       vertical(n.nw, n.sw), centre(id),      vertical(n.ne, n.se),
+                       n.sw,          horizontal(n.sw, n.se), n.se};
+
+        bool fullSpeed = j == n.level - 2;
+        for (NodeId& square : s) square = fullSpeed ? successor(square, j - 1) : centre(square);
+
+        int inner = fullSpeed ? j - 1 : j;
+        result    = join(successor(join(s[0], s[1], s[3], s[4]), inner), successor(join(s[1], s[2], s[4], s[5]), inner),
+                         successor(join(s[3], s[4], s[6], s[7]), inner), successor(join(s[4], s[5], s[7], s[8]), inner));
+    }
+
+    nodes[id].result     = result;
+    nodes[id].resultStep = (int8_t)j;
+    return result;
+}
+
+// Is every live cell of 'n' inside its middle quarter (center of the center)?
+bool HashLife::innerQuarterHoldsAll(NodeId id) const {
+    const Node& n = nodes[id];
+    if (n.level < 3)
+        return n.population == 0;
+
+    uint64_t inner = nodes[nodes[nodes[n.nw].se].se].population + nodes[nodes[nodes[n.ne].sw].sw].population +
+                     nodes[nodes[nodes[n.sw].ne].ne].population + nodes[nodes[nodes[n.se].nw].nw].population;
+    return inner == n.population;
+}
+
+// --------------------------------------------------------------
+// stepRoot(k): advance the whole universe 2^k generations.
+// The root is grown until the pattern sits in its inner quarter
+// and the level is at least k + 3; nothing can then travel out of
+// the RESULT square in 2^k generations (light speed is 1 cell/gen).
+// --------------------------------------------------------------
+void HashLife::stepRoot(int k) {
+    if (liveNodes > maxNodes)
+        collectGarbage(true);
+    if (liveNodes > maxNodes / 2)
+        collectGarbage(false);
+
+    while (nodes[root].level < k + 3 || !innerQuarterHoldsAll(root)) root = expand(root);
+
+    root = successor(root, k);
+    generation += (uint64_t)1 << k;
+}
+
+// --------------------------------------------------------------
+// Cell access. (row, col) are relative to the node's top-left.
+// --------------------------------------------------------------
+bool HashLife::cellIn(NodeId id, int64_t row, int64_t col) const {
+    while (nodes[id].level > 0) {
+        const Node& n = nodes[id];
+        int64_t half  = (int64_t)1 << (n.level - 1);
+        bool south = row >= half, east = col >= half;
+        id         = south ? (east ? n.se : n.sw) : (east ? n.ne : n.nw);
+        row -= south ? half : 0;
+        col -= east ? half : 0;
+    }
+    return id == 1;
+}
+
+HashLife::NodeId HashLife::withCell(NodeId id, int64_t row, int64_t col, bool alive) {
+    Node n = nodes[id];
+    if (n.level == 0)
+        return alive ? 1 : 0;
+
+    int64_t half = (int64_t)1 << (n.level - 1);
+    bool south = row >= half, east = col >= half;
+    int64_t r  = south ? row - half : row;
+    int64_t c  = east ? col - half : col;
+
+    if (!south && !east)
+        return join(withCell(n.nw, r, c, alive), n.ne, n.sw, n.se);
+    if (!south)
+        return join(n.nw, withCell(n.ne, r, c, alive), n.sw, n.se);
+    if (!east)
+        return join(n.nw, n.ne, withCell(n.sw, r, c, alive), n.se);
+    return join(n.nw, n.ne, n.sw, withCell(n.se, r, c, alive));
+}
+
+uint8_t HashLife::getUniverseCell(int64_t row, int64_t col) const {
+    int64_t half = rootHalf();
+    if (row < -half || row >= half || col < -half || col >= half)
+        return 0;
+    return cellIn(root, row + half, col + half);
+}
+
+void HashLife::setUniverseCell(int64_t row, int64_t col, uint8_t state) {
+    while (row < -rootHalf() || row >= rootHalf() || col < -rootHalf() || col >= rootHalf()) root = expand(root);
+    root = withCell(root, row + rootHalf(), col + rootHalf(), state != 0);
+}
+
+// --------------------------------------------------------------
+// draw: write the live cells of node 'n' (top-left at universe
+// (top, left)) that fall inside the requested region. Empty
+// squares and squares outside the region are skipped whole.
+// --------------------------------------------------------------
+void HashLife::draw(NodeId id, int64_t top, int64_t left, int64_t rTop, int64_t rLeft, int rCount, int cCount,
+                    uint8_t* out, int outStride) const {
+    const Node& n = nodes[id];
+    int64_t size  = (int64_t)1 << n.level;
+
+    if (n.population == 0 || top >= rTop + rCount || left >= rLeft + cCount || top + size <= rTop ||
+        left + size <= rLeft)
+        return;
+
+    if (n.level == 0) {
+        out[(top - rTop) * outStride + (left - rLeft)] = 1;
+        return;
+    }
+
+    int64_t half = size / 2;
+    draw(n.nw, top, left, rTop, rLeft, rCount, cCount, out, outStride);
+    draw(n.ne, top, left + half, rTop, rLeft, rCount, cCount, out, outStride);
+    draw(n.sw, top + half, left, rTop, rLeft, rCount, cCount, out, outStride);
+    draw(n.se, top + half, left + half, rTop, rLeft, rCount, cCount, out, outStride);
+}
+
+void HashLife::drawRegion(int64_t top, int64_t left, int rowCount, int colCount, uint8_t* out,
+                          int outStride) const {
+    draw(root, -rootHalf(), -rootHalf(), top, left, rowCount, colCount, out, outStride);
+}
+
+// --------------------------------------------------------------
+// Stepping
+// --------------------------------------------------------------
+void HashLife::stepPow2(int k) {
+    importEdits();
+    stepRoot(k);
+    exportViewport();
+}
+
+void HashLife::advance(uint64_t gens) {
+    importEdits();
+    for (int k = 0; gens; k++, gens >>= 1)
+        if (gens & 1)
+            stepRoot(k);
+    exportViewport();
+}
+
+void HashLife::step() {
+    advance(1);
+}
+
+void HashLife::step(int gens) {
+    advance(gens > 0 ? (uint64_t)gens : 0);
+}
+
+void HashLife::setRule(const LifeRule& r) {
+    if (r.bornFromNothing())
+        throw std::invalid_argument("B0 rules need a bounded board: " + r.toString());
+    rule = r;
+    for (Node& n : nodes) n.result = NONE;
+}
+
+// --------------------------------------------------------------
+// Garbage collection
+// --------------------------------------------------------------
+void HashLife::setMemoryLimit(size_t megabytes) {
+    maxNodes = megabytes * 1024 * 1024 / sizeof(Node);
+}
+
+void HashLife::mark(NodeId id, bool keepResults) {
+    Node& n = nodes[id];
+    if (n.mark)
+        return;
+    n.mark = 1;
+    if (n.level == 0)
+        return;
+
+    mark(n.nw, keepResults);
+    mark(n.ne, keepResults);
+    mark(n.sw, keepResults);
+    mark(n.se, keepResults);
+    if (keepResults && n.result != NONE)
+        mark(n.result, keepResults);
+}
+
+void HashLife::collectGarbage(bool keepResults) {
+    for (Node& n : nodes) n.mark = 0;
+
+    mark(0, keepResults);
+    mark(1, keepResults);
+    for (NodeId e : emptyNode) mark(e, keepResults);
+    mark(root, keepResults);
+
+    for (NodeId id = 2; id < nodes.size(); id++) {
+        Node& n = nodes[id];
+        if (n.free)
+            continue;
+        if (!n.mark) {
+            n.free = 1;
+            freeList.push_back(id);
+            liveNodes--;
+        } else if (!keepResults) {
+            n.result = NONE;
+        }
+    }
+    rehash(buckets.size());
+}
+
+// --------------------------------------------------------------
+// Output
+// --------------------------------------------------------------
+void HashLife::printStats(std::ostream& out) const {
+    out << "hashlife: rule " << rule.toString() << ", generation " << generation << ", population " << getPopulation() << ", " << liveNodes
+        << " nodes (" << liveNodes * sizeof(Node) / (1024 * 1024) << " MB of " << maxNodes * sizeof(Node) / (1024 * 1024)
+        << " MB), root level " << (int)nodes[root].level << "\n";
+}
@@ -0,0 +1,304 @@
+#pragma once
+
+#include "CellularAutomaton.hpp"
+#include "Parallel.hpp"
+#include <cctype>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// --------------------------------------------------------------
+// LtLRule:
+// A Larger-than-Life rule: like Life, but a cell counts the live
+// cells in the (2R+1) x (2R+1) box around it, and birth / survival
+// are ranges of counts. Written the way Golly does, e.g. Bosco's
+// rule:
+//
+//     R5,C0,M1,S34..58,B34..45,NM
+//
+//   R  radius (1..500)
+//   C  states; 0 or 2 = alive/dead, more = dying cells fade out
+//      through states 2..C-1 like a Generations rule
+//   M  1 = the cell counts itself, 0 = it does not
+//   S  a live cell with a count in lo..hi survives
+//   B  a dead cell with a count in lo..hi is born
+//   N  neighborhood; only M (Moore, the box) is supported
+//
+// Only state-1 cells are counted.
+// --------------------------------------------------------------
+struct LtLRule {
+    int radius;
+    int states;  // 2..255
+    bool middle;
+    int surviveLo, surviveHi;
+    int birthLo, birthHi;
+
+    // Bosco's rule: R5,C0,M1,S34..58,B34..45,NM
+    static LtLRule bosco() {
+        return {5, 2, true, 34, 58, 34, 45};
+    }
+
+    std::string toString() const {
+        return "R" + std::to_string(radius) + ",C" + std::to_string(states == 2 ? 0 : states) + ",M" +
+               std::to_string((int)middle) + ",S" + std::to_string(surviveLo) + ".." + std::to_string(surviveHi) +
+               ",B" + std::to_string(birthLo) + ".." + std::to_string(birthHi) + ",NM";
+    }
+
+    // Throws std::invalid_argument if a field is out of range.
+    void validate() const {
+        if (radius < 1 || radius > 500)
+            throw std::invalid_argument("LtL radius must be 1..500");
+        if (states < 2 || states > 255)
+            throw std::invalid_argument("LtL rules need 2..255 states");
+    }
+
+    // ----------------------------------------------------------
+    // parse(text):
+    // Accepts "R5,C0,M1,S34..58,B34..45,NM" (fields in any order,
+    // C, M and N optional) and the name bosco.
+    // Throws std::invalid_argument for anything else.
+    // ----------------------------------------------------------
+    static LtLRule parse(const std::string& text) {
+        std::string t;
+        for (char ch : text)
+            if (!std::isspace((unsigned char)ch))
+                t += (char)std::tolower((unsigned char)ch);
+
+        if (t == "bosco")
+            return bosco();
+
+        auto fail = [&]() { return std::invalid_argument("Unknown Larger-than-Life rule: " + text); };
+        auto number = [&](const std::string& digits) {
+            if (digits.empty() || digits.size() > 6 || digits.find_first_not_of("0123456789") != std::string::npos)
+                throw fail();
+            return std::stoi(digits);
+        };
+        auto range = [&](const std::string& field, int& lo, int& hi) {
+            size_t dots = field.find("..");
+            lo          = number(field.substr(0, dots));
+            hi          = dots == std::string::npos ? lo : number(field.substr(dots + 2));
+        };
+
+        LtLRule rule{0, 2, false, 1, 0, 1, 0};
+        bool haveR = false, haveS = false, haveB = false;
+        size_t start = 0;
+        while (start <= t.size()) {
+            size_t comma      = t.find(',', start);
+            std::string field = t.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+            start             = comma == std::string::npos ? t.size() + 1 : comma + 1;
+            if (field.empty())
+                throw fail();
+
+            std::string value = field.substr(1);
+            switch (field[0]) {
+                case 'r':
+                    rule.radius = number(value);
+                    haveR       = true;
+                    break;
+                case 'c':
+                    rule.states = number(value);
+                    if (rule.states == 0)
+                        rule.states = 2;
+                    break;
+                case 'm':
+                    if (value != "0" && value != "1")
+                        throw fail();
+                    rule.middle = value == "1";
+                    break;
+                case 's':
+                    range(value, rule.surviveLo, rule.surviveHi);
+                    haveS = true;
+                    break;
+                case 'b':
+                    range(value, rule.birthLo, rule.birthHi);
+                    haveB = true;
+                    break;
+                case 'n':
+                    if (value != "m")
+                        throw std::invalid_argument("Only Moore (NM) Larger-than-Life neighborhoods are supported: " + text);
+                    break;
+                default:
+                    throw fail();
+            }
+        }
+
+        if (!haveR || !haveS || !haveB)
+            throw fail();
+        rule.validate();
+        return rule;
+    }
+};
+
+// --------------------------------------------------------------
+// LargerThanLife:
+// CellularAutomaton for LtL rules with any radius. A direct count
+// costs (2R+1)^2 per cell; instead, each generation builds a
+// summed-area table over the board (padded by R cells taken from
+// the boundary policy):
+//
+//     sums[i][j] = number of live cells in padded rows < i, cols < j
+//
+// so the box count for any cell is four lookups, whatever R is:
+//
+//     count = sums[r+2R+1][c+2R+1] - sums[r][c+2R+1]
+//           - sums[r+2R+1][c]      + sums[r][c]
+//
+// All three passes (row prefix sums, column accumulation, rule)
+// are split across 'threads' bands of a ThreadPool that is built
+// on the first step and kept, as ConwayLife does.
+// --------------------------------------------------------------
+class LargerThanLife : public CellularAutomaton {
+   private:
+    LtLRule rule;
+    int threads;
+    std::unique_ptr<ThreadPool> pool;  // 'threads' bands, built on first use and kept
+    std::vector<uint32_t> sums;        // (rows + 2R + 1) x (cols + 2R + 1)
+    CellBuffer back;
+
+    ThreadPool& bandPool() {
+        if (!pool || pool->size() != threads)
+            pool = std::make_unique<ThreadPool>(threads);
+        return *pool;
+    }
+
+    int sumsStride() const {
+        return cols + 2 * rule.radius + 1;
+    }
+
+    // Padded row i / column j (0 .. size+2R-1) -> live (state 1) or not
+    void prefixRow(int i) {
+        const int R      = rule.radius;
+        uint32_t* out    = &sums[(size_t)(i + 1) * sumsStride()];
+        int source       = i - R;
+        uint32_t running = 0;
+        out[0]           = 0;
+
+        if (source < 0 || source >= rows)
+            source = haloSource(source, rows, boundary);
+        if (source < 0) {  // Dead / Alive: the whole padded row is constant
+            uint32_t value = boundary == Boundary::Alive;
+            for (int j = 0; j < cols + 2 * R; j++) out[j + 1] = running += value;
+            return;
+        }
+
+        const uint8_t* row = &at(source, 0);
+        auto alive = [&](int c) -> uint32_t {
+            if (c < 0 || c >= cols) {
+                c = haloSource(c, cols, boundary);
+                if (c < 0)
+                    return boundary == Boundary::Alive;
+            }
+            return row[c] == 1;
+        };
+
+        for (int j = 0; j < R; j++) out[j + 1] = running += alive(j - R);
+        for (int c = 0; c < cols; c++) out[R + c + 1] = running += (row[c] == 1);
+        for (int j = R + cols; j < cols + 2 * R; j++) out[j + 1] = running += alive(j - R);
+    }
+
+    void stepRows(int first, int last) {
+        const int R          = rule.radius;
+        const int S          = sumsStride();
+        const uint8_t states = (uint8_t)rule.states;
+
+        for (int r = first; r < last; r++) {
+            const uint32_t* top    = &sums[(size_t)r * S];
+            const uint32_t* bottom = &sums[(size_t)(r + 2 * R + 1) * S];
+            const uint8_t* self    = &at(r, 0);
+            uint8_t* out           = &back[(size_t)(r + halo) * stride + halo];
+
+            for (int c = 0; c < cols; c++) {
+                int count = (int)(bottom[c + 2 * R + 1] - top[c + 2 * R + 1] - bottom[c] + top[c]);
+                uint8_t s = self[c];
+                if (s == 1 && !rule.middle)
+                    count--;  // the box includes the cell itself
+
+                if (s == 0)
+                    out[c] = count >= rule.birthLo && count <= rule.birthHi;
+                else if (s == 1 && count >= rule.surviveLo && count <= rule.surviveHi)
+                    out[c] = 1;
+                else
+                    out[c] = s + 1 == states ? 0 : s + 1;
+            }
+        }
+    }
+
+   public:
+    LargerThanLife(int r, int c, const LtLRule& ltl = LtLRule::bosco())
+        : CellularAutomaton(r, c), rule(ltl), threads(defaultThreadCount()), back(cells.size(), 0) {
+        setRule(ltl);
+        randomize(0.5);  // Bosco's rule needs a dense start
+    }
+
+    // Throws std::invalid_argument for an out-of-range rule.
+    void setRule(const LtLRule& ltl) {
+        ltl.validate();
+        rule = ltl;
+        sums.assign((size_t)(rows + 2 * rule.radius + 1) * sumsStride(), 0);
+    }
+    const LtLRule& getRule() const {
+        return rule;
+    }
+
+    void setThreads(int n) {
+        threads = std::max(1, n);
+        pool.reset();
+    }
+    int getThreads() const {
+        return threads;
+    }
+
+    int stateCount() const override {
+        return rule.states;
+    }
+
+    using CellularAutomaton::step;  // step(gens) loops over step()
+
+    void step() override {
+        const int S         = sumsStride();
+        const int height    = rows + 2 * rule.radius;
+        ThreadPool& workers = bandPool();
+
+        // 1. prefix sums along every padded row (row 0 of 'sums' stays zero)
+        workers.split(height, [this](int first, int last) {
+            for (int i = first; i < last; i++) prefixRow(i);
+        });
+
+        // 2. accumulate down the columns, one band of columns per thread
+        workers.split(S, [this, S, height](int first, int last) {
+            for (int i = 2; i <= height; i++) {
+                uint32_t* row        = &sums[(size_t)i * S];
+                const uint32_t* prev = &sums[(size_t)(i - 1) * S];
+                for (int j = first; j < last; j++) row[j] += prev[j];
+            }
+        });
+
+        // 3. apply the rule from four lookups per cell
+        workers.split(rows, [this](int first, int last) { stepRows(first, last); });
+
+        cells.swap(back);
+    }
+
+    // '#' alive, '+' dying, ' ' dead
+    void display() const override {
+        GridView grid = getGrid();
+
+        for (int r = 0; r < grid.size(); r++) {
+            for (uint8_t cell : grid[r]) std::cout << (cell == 1 ? '#' : cell ? '+' : ' ');
+            std::cout << "\n";
+        }
+    }
+
+    void printStats(std::ostream& out) const override {
+        long alive    = 0;
+        GridView grid = getGrid();
+        for (int r = 0; r < grid.size(); r++)
+            for (uint8_t cell : grid[r]) alive += cell == 1;
+
+        out << "ltl: rule " << rule.toString() << ", threads " << threads << ", alive " << alive
+            << ", summed-area table " << sums.size() * sizeof(uint32_t) / 1024 << " KB\n";
+    }
+};
@@ -0,0 +1,313 @@
+#pragma once
+
+#include "CellularAutomaton.hpp"
+#include "FFT.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// --------------------------------------------------------------
+// LeniaParams:
+// A Lenia rule. Every cell holds a value in [0, 1]; each step
+//
+//     U = K * A                       (convolution with the kernel)
+//     A = clamp(A + dt * G(U), 0, 1)
+//     G(u) = 2 exp(-(u - mu)^2 / (2 sigma^2)) - 1
+//
+// K is a smooth ring of radius 'radius' cells, normalized to sum
+// to 1. With several 'peaks' it is that many concentric rings, of
+// those heights. The defaults are Orbium (the Lenia "glider").
+// --------------------------------------------------------------
+struct LeniaParams {
+    int radius  = 13;
+    float mu    = 0.15f;
+    float sigma = 0.015f;
+    float dt    = 0.1f;
+    std::vector<float> peaks = {1.0f};
+
+    // Throws std::invalid_argument if a field is out of range.
+    void validate() const {
+        if (radius < 1 || radius > 1000)
+            throw std::invalid_argument("Lenia radius must be 1..1000");
+        if (sigma <= 0 || dt <= 0 || dt > 1)
+            throw std::invalid_argument("Lenia needs sigma > 0 and 0 < dt <= 1");
+        if (peaks.empty())
+            throw std::invalid_argument("Lenia needs at least one kernel peak");
+    }
+};
+
+// --------------------------------------------------------------
+// Lenia:
+// Continuous CellularAutomaton over a float field. The kernel is
+// (2R+1)^2 cells, so a direct convolution costs O(N K^2); here it
+// is done in the frequency domain instead:
+//
+//     U = inverse(forward(A) x spectrum(K))      O(N log N)
+//
+// The kernel spectrum is computed once per size / rule and cached.
+// The FFT (RealFFT2D) needs power-of-two sizes: a toroidal board
+// with power-of-two sides is transformed as is; otherwise the
+// field is padded by R cells on every side from the boundary
+// policy, up to the next power of two, so the circular
+// convolution never wraps into real cells.
+//
+// The byte grid mirrors the field as 0..255 (value * 255) for
+// renderers (stateCount() = 256). Cells edited through the base
+// class are copied back into the field before the next step:
+// byte 1 (setCell / mouse clicks) paints a full-strength cell.
+// --------------------------------------------------------------
+class Lenia : public CellularAutomaton {
+   private:
+    LeniaParams params;
+    int threads;
+    std::unique_ptr<ThreadPool> pool;  // 'threads' bands, built on first use and kept
+    std::vector<float> field;          // rows x cols, values in [0, 1]
+    bool edited = false;
+
+    // FFT plan for the current size, boundary and rule
+    int padRows = 0, padCols = 0;
+    Boundary planBoundary = Boundary::Dead;
+    std::unique_ptr<RealFFT2D> fft;
+    std::vector<float> padded;             // padRows x padCols
+    std::vector<Complex> spectrum;         // padRows x (padCols/2 + 1)
+    std::vector<Complex> kernelSpectrum;
+
+    static uint8_t toByte(float v) {
+        return (uint8_t)(v * 255.0f + 0.5f);
+    }
+
+    void cellsChanged() override {
+        edited = true;
+    }
+
+    // Copy cells edited through the byte grid into the field.
+    void importEdits() {
+        if (!edited)
+            return;
+        edited = false;
+
+        for (int r = 0; r < rows; r++)
+            for (int c = 0; c < cols; c++) {
+                float& v = field[(size_t)r * cols + c];
+                uint8_t b = at(r, c);
+                if (b != toByte(v))
+                    v = b == 1 ? 1.0f : b / 255.0f;
+            }
+    }
+
+    // Choose the FFT size for the boundary and cache the kernel spectrum.
+    void buildPlan() {
+        const int R  = params.radius;
+        bool wrapped = boundary == Boundary::Toroidal && isPowerOfTwo(rows) && isPowerOfTwo(cols) && cols >= 2;
+        padRows      = wrapped ? rows : nextPowerOfTwo(rows + 2 * R);
+        padCols      = wrapped ? cols : nextPowerOfTwo(std::max(2, cols + 2 * R));
+        planBoundary = boundary;
+
+        fft = std::make_unique<RealFFT2D>(padRows, padCols);
+        padded.assign((size_t)padRows * padCols, 0.0f);
+        spectrum.assign((size_t)padRows * fft->spectrumCols(), Complex());
+
+        // Kernel centred on cell (0, 0); negative offsets wrap around
+        std::vector<float> weights = ringKernel(params);
+        for (int dr = -R; dr <= R; dr++)
+            for (int dc = -R; dc <= R; dc++) {
+                int pr = ((dr % padRows) + padRows) % padRows, pc = ((dc % padCols) + padCols) % padCols;
+                padded[(size_t)pr * padCols + pc] += weights[(size_t)(dr + R) * (2 * R + 1) + (dc + R)];
+            }
+        kernelSpectrum.assign(spectrum.size(), Complex());
+        fft->forward(padded.data(), kernelSpectrum.data(), bandPool());
+    }
+
+    ThreadPool& bandPool() {
+        if (!pool || pool->size() != threads)
+            pool = std::make_unique<ThreadPool>(threads);
+        return *pool;
+    }
+
+    // Padded row / column p -> board row / column, CONSTANT for a
+    // Dead / Alive margin, or GAP for the unused middle of the padding.
+    static constexpr int CONSTANT = -1, GAP = -2;
+
+    static int padSource(int p, int n, int padN, int R, Boundary b) {
+        if (p < n)
+            return p;
+        int v;
+        if (p < n + R)
+            v = p;  // below / right of the board
+        else if (p >= padN - R)
+            v = p - padN;  // above / left of it (wrapped around)
+        else
+            return GAP;
+        int source = haloSource(v, n, b);
+        return source < 0 ? CONSTANT : source;
+    }
+
+    void fillPadded(int first, int last) {
+        const int R          = params.radius;
+        const float constant = planBoundary == Boundary::Alive ? 1.0f : 0.0f;
+
+        for (int pr = first; pr < last; pr++) {
+            float* out = &padded[(size_t)pr * padCols];
+            int sr     = padSource(pr, rows, padRows, R, planBoundary);
+            if (sr < 0) {
+                std::fill(out, out + padCols, sr == GAP ? 0.0f : constant);
+                continue;
+            }
+
+            const float* src = &field[(size_t)sr * cols];
+            std::copy(src, src + cols, out);
+            for (int pc = cols; pc < padCols; pc++) {
+                int sc  = padSource(pc, cols, padCols, R, planBoundary);
+                out[pc] = sc >= 0 ? src[sc] : (sc == GAP ? 0.0f : constant);
+            }
+        }
+    }
+
+    void growRows(int first, int last) {
+        for (int r = first; r < last; r++) {
+            const float* potential = &padded[(size_t)r * padCols];
+            float* value           = &field[(size_t)r * cols];
+            uint8_t* shown         = &at(r, 0);
+
+            for (int c = 0; c < cols; c++) {
+                float v  = std::min(1.0f, std::max(0.0f, value[c] + params.dt * growth(params, potential[c])));
+                value[c] = v;
+                shown[c] = toByte(v);
+            }
+        }
+    }
+
+   public:
+    Lenia(int r, int c, const LeniaParams& p = LeniaParams())
+        : CellularAutomaton(r, c), params(p), threads(defaultThreadCount()), field((size_t)r * c, 0.0f) {
+        params.validate();
+        boundary = Boundary::Toroidal;  // Lenia's usual world
+        seedNoise(0.5);
+    }
+
+    // ----------------------------------------------------------
+    // ringKernel(params): the (2R+1) x (2R+1) kernel weights, row
+    // major, summing to 1. At distance d (in units of R) ring
+    // i = floor(d * B) of B peaks contributes
+    //     peaks[i] * exp(4 - 1 / (x (1 - x))),  x = d*B - i
+    // ----------------------------------------------------------
+    static std::vector<float> ringKernel(const LeniaParams& p) {
+        const int R = p.radius, B = (int)p.peaks.size(), side = 2 * R + 1;
+        std::vector<double> weights((size_t)side * side, 0.0);
+        double total = 0;
+
+        for (int dr = -R; dr <= R; dr++)
+            for (int dc = -R; dc <= R; dc++) {
+                double d = std::sqrt((double)dr * dr + (double)dc * dc) / R * B;
+                int ring = (int)d;
+                double x = d - ring;
+                if (ring >= B || x <= 0 || x >= 1)
+                    continue;
+                double w = p.peaks[ring] * std::exp(4.0 - 1.0 / (x * (1.0 - x)));
+                weights[(size_t)(dr + R) * side + (dc + R)] = w;
+                total += w;
+            }
+
+        std::vector<float> out(weights.size());
+        for (size_t i = 0; i < out.size(); i++) out[i] = total > 0 ? (float)(weights[i] / total) : 0.0f;
+        return out;
+    }
+
+    // Growth mapping G(u) in [-1, 1].
+    static float growth(const LeniaParams& p, float u) {
+        float d = (u - p.mu) / p.sigma;
+        return 2.0f * std::exp(-0.5f * d * d) - 1.0f;
+    }
+
+    // Throws std::invalid_argument for out-of-range parameters.
+    void setParams(const LeniaParams& p) {
+        p.validate();
+        params = p;
+        fft.reset();
+    }
+    const LeniaParams& getParams() const {
+        return params;
+    }
+
+    void setThreads(int n) {
+        threads = std::max(1, n);
+        pool.reset();
+    }
+    int getThreads() const {
+        return threads;
+    }
+
+    // Field access (values in [0, 1]).
+    float getValue(int r, int c) const {
+        return field[(size_t)r * cols + c];
+    }
+    void setValue(int r, int c, float v) {
+        importEdits();
+        v                          = std::min(1.0f, std::max(0.0f, v));
+        field[(size_t)r * cols + c] = v;
+        at(r, c)                   = toByte(v);
+    }
+
+    // Random values in [0, 1) over the middle 'fraction' of the board
+    // (rand(), so srand() makes it repeatable).
+    void seedNoise(double fraction) {
+        std::fill(field.begin(), field.end(), 0.0f);
+        int h = (int)(rows * fraction), w = (int)(cols * fraction);
+        for (int r = (rows - h) / 2; r < (rows + h) / 2; r++)
+            for (int c = (cols - w) / 2; c < (cols + w) / 2; c++)
+                field[(size_t)r * cols + c] = (float)std::rand() / ((float)RAND_MAX + 1.0f);
+
+        for (int r = 0; r < rows; r++)
+            for (int c = 0; c < cols; c++) at(r, c) = toByte(field[(size_t)r * cols + c]);
+        edited = false;
+    }
+
+    int stateCount() const override {
+        return 256;
+    }
+
+    using CellularAutomaton::step;  // step(gens) loops over step()
+
+    void step() override {
+        importEdits();
+        if (!fft || planBoundary != boundary)
+            buildPlan();
+
+        const int half      = fft->spectrumCols();
+        ThreadPool& workers = bandPool();
+        workers.split(padRows, [this](int first, int last) { fillPadded(first, last); });
+        fft->forward(padded.data(), spectrum.data(), workers);
+        workers.split(padRows, [&](int first, int last) {
+            for (size_t i = (size_t)first * half; i < (size_t)last * half; i++) {
+                Complex a = spectrum[i], k = kernelSpectrum[i];
+                spectrum[i] = Complex(a.real() * k.real() - a.imag() * k.imag(), a.real() * k.imag() + a.imag() * k.real());
+            }
+        });
+        fft->inverse(spectrum.data(), padded.data(), workers);  // padded now holds U
+        workers.split(rows, [this](int first, int last) { growRows(first, last); });
+    }
+
+    // Shades from ' ' (0) to '@' (1)
+    void display() const override {
+        static const char shades[] = " .:-=+*#%@";
+        for (int r = 0; r < rows; r++) {
+            for (int c = 0; c < cols; c++) std::cout << shades[std::min(9, (int)(field[(size_t)r * cols + c] * 10))];
+            std::cout << "\n";
+        }
+    }
+
+    void printStats(std::ostream& out) const override {
+        double mass = 0;
+        for (float v : field) mass += v;
+
+        out << "lenia: R " << params.radius << ", mu " << params.mu << ", sigma " << params.sigma << ", dt "
+            << params.dt << ", " << params.peaks.size() << " ring(s), FFT " << padRows << "x" << padCols
+            << ", threads " << threads << ", mass " << mass << "\n";
+    }
+};
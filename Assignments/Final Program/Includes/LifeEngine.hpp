@@ -0,0 +1,121 @@
+#pragma once
+
+#include "CellularAutomaton.hpp"
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// --------------------------------------------------------------
+// LifeEngine:
+// Interchangeable "backend" that computes Game of Life generations
+// for ConwayLife. The model owns the byte grid; an engine only
+// knows how to turn one generation into the next.
+//
+// Derived engines MUST implement step(); engines that keep their
+// own representation (bit-packed words, tile flags, ...) override
+// run() so several generations happen without touching the bytes,
+// and invalidate() so they notice edits made through the model.
+// --------------------------------------------------------------
+class LifeEngine {
+   public:
+    virtual ~LifeEngine() = default;
+
+    // Short name used by the engine= command-line argument.
+    virtual const char* name() const = 0;
+
+    // ----------------------------------------------------------
+    // step(src, dst):
+    // Compute ONE generation. Reads 'src' and writes the result
+    // into 'dst', which has the same rows, cols and stride.
+    // The halo around 'src' (at least one cell) is already filled,
+    // so src[-1][c], src[r][cols], ... can be read without checks.
+    // ----------------------------------------------------------
+    virtual void step(const GridView& src, uint8_t* dst) = 0;
+
+    // ----------------------------------------------------------
+    // run(cur, next, layout, gens):
+    // Advance 'gens' generations of the halo-padded buffer 'cur'.
+    // 'next' is scratch space of the same size; on return 'cur'
+    // holds the newest board.
+    //
+    // Toroidal / mirror halos are refilled every generation. Dead /
+    // alive halos never change, so they are written into both
+    // buffers once and reused while the buffers and policy stay the
+    // same. Any other policy, or invalidate(), forgets them: a
+    // toroidal run leaves wrapped cells in both halos.
+    // ----------------------------------------------------------
+    virtual void run(CellBuffer& cur, CellBuffer& next, const GridLayout& layout, int gens) {
+        size_t origin = layout.origin();
+        bool constant = isConstantBoundary(layout.boundary);
+
+        if (constant && !constantHaloReady(cur, next, layout.boundary)) {
+            fillHalo(cur.data(), layout);
+            fillHalo(next.data(), layout);
+            haloBuffers[0] = cur.data();
+            haloBuffers[1] = next.data();
+            haloBoundary   = layout.boundary;
+        }
+
+        if (!constant)
+            forgetHalo();
+
+        for (int g = 0; g < gens; g++) {
+            if (!constant)
+                fillHalo(cur.data(), layout);
+            step(GridView(cur.data() + origin, layout.rows, layout.cols, layout.stride), next.data() + origin);
+            cur.swap(next);
+        }
+    }
+
+    // Called when cells or the boundary were changed outside of
+    // step()/run(). Overrides must call LifeEngine::invalidate().
+    virtual void invalidate() {
+        forgetHalo();
+    }
+
+    // Worker threads for engines that schedule their own parallel
+    // work (ConwayLife::setThreads passes its count on).
+    virtual void setThreads(int) {
+    }
+
+    // ----------------------------------------------------------
+    // splitsIntoBands():
+    // True if one board may be stepped as separate row bands, each
+    // by its own instance of this engine calling step() on its
+    // band (see ConwayLife::setThreads). Engines that remember the
+    // board between generations (changed tiles, a packed copy)
+    // keep the default and run single-threaded.
+    // ----------------------------------------------------------
+    virtual bool splitsIntoBands() const {
+        return false;
+    }
+
+    // ----------------------------------------------------------
+    // needsScratch():
+    // False if run() ignores its 'next' buffer because the engine
+    // steps its own copy of the board; ConwayLife then frees its
+    // back buffer while this engine is selected.
+    // ----------------------------------------------------------
+    virtual bool needsScratch() const {
+        return true;
+    }
+
+    // Engine-specific statistics (work skipped, ...), if any.
+    virtual void printStats(std::ostream&) const {
+    }
+
+   private:
+    // Buffers whose constant halo run() has already written.
+    const uint8_t* haloBuffers[2] = {nullptr, nullptr};
+    Boundary haloBoundary         = Boundary::Dead;
+
+    void forgetHalo() {
+        haloBuffers[0] = haloBuffers[1] = nullptr;
+    }
+
+    bool constantHaloReady(const CellBuffer& a, const CellBuffer& b, Boundary policy) const {
+        bool same = (a.data() == haloBuffers[0] && b.data() == haloBuffers[1]) ||
+                    (a.data() == haloBuffers[1] && b.data() == haloBuffers[0]);
+        return same && policy == haloBoundary;
+    }
+};
@@ -0,0 +1,636 @@
+#pragma once
+
+#include "AutomatonUtils.hpp"
+#include "LifeRule.hpp"
+#include "SimdEngine.hpp"
+#include "TemporalBlockEngine.hpp"
+#include "WorkStealing.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// --------------------------------------------------------------
+// stepEnsembleRows:
+// One generation of up to 64 bit-sliced boards.
+//
+// Every word is one cell of the board for all 64 boards at once:
+// bit k belongs to board k. So a cell's neighbors are simply the
+// neighboring words (no shifting), and each adder step below
+// works on 64 boards.
+//
+// The count is built like stepSummedRows(): each row's horizontal
+// sums (words c-1 + c + c+1, two bit-planes) are computed once,
+// kept in 'sums' (3 rows x 2 planes x 'stride' words) for the
+// three output rows around it, and summedWord() adds them up.
+//
+// Buffers are (rows + 2) x stride words, stride = cols + 2, with
+// a one-cell halo; only the inner words of 'next' are written.
+// 'changed' gets every board (bit) whose cells differ between
+// 'cur' and 'next'; 'changed2' every board whose 'next' differs
+// from 'prev' (two generations back), and 'changedSnap' every
+// board whose 'next' differs from 'snap' (any older generation).
+//
+// The AVX2 version does 4 words (4 cells x 64 boards) at a time.
+// --------------------------------------------------------------
+inline void ensembleRowSums(const uint64_t* row, uint64_t* ones, uint64_t* twos, int cols) {
+    for (int c = 1; c <= cols; c++) {
+        uint64_t w = row[c - 1], x = row[c], e = row[c + 1], we = w ^ e;
+        ones[c] = we ^ x;
+        twos[c] = (w & e) | (x & we);
+    }
+}
+
+template <uint32_t Rule = LifeRule::conway().mask()>
+inline void stepEnsembleRows(const uint64_t* prev, const uint64_t* snap, const uint64_t* cur, uint64_t* next, int rows,
+                             int cols, uint64_t* sums, uint32_t ruleMask, uint64_t& changed, uint64_t& changed2,
+                             uint64_t& changedSnap) {
+    const int stride  = cols + 2;
+    uint64_t* ones[3] = {sums, sums + 2 * stride, sums + 4 * stride};  // rows r-1, r, r+1 (rotating)
+    uint64_t* twos[3] = {sums + stride, sums + 3 * stride, sums + 5 * stride};
+    uint64_t diff1 = 0, diff2 = 0, diffSnap = 0;
+
+    ensembleRowSums(cur, ones[0], twos[0], cols);
+    ensembleRowSums(cur + stride, ones[1], twos[1], cols);
+
+    for (int r = 1; r <= rows; r++) {
+        ensembleRowSums(cur + (size_t)(r + 1) * stride, ones[2], twos[2], cols);
+
+        const uint64_t* mid = cur + (size_t)r * stride;
+        const uint64_t* old = prev + (size_t)r * stride;
+        const uint64_t* was = snap + (size_t)r * stride;
+        uint64_t* out       = next + (size_t)r * stride;
+        for (int c = 1; c <= cols; c++) {
+            summedWord<Rule>(out[c], ones[0][c], ones[1][c], ones[2][c], twos[0][c], twos[1][c], twos[2][c], mid[c],
+                             ruleMask);
+            diff1 |= out[c] ^ mid[c];
+            diff2 |= out[c] ^ old[c];
+            diffSnap |= out[c] ^ was[c];
+        }
+
+        std::swap(ones[0], ones[1]);
+        std::swap(ones[1], ones[2]);
+        std::swap(twos[0], twos[1]);
+        std::swap(twos[1], twos[2]);
+    }
+
+    changed     = diff1;
+    changed2    = diff2;
+    changedSnap = diffSnap;
+}
+
+#ifdef LIFE_X86_SIMD
+__attribute__((target("avx2"))) inline void ensembleRowSumsAVX2(const uint64_t* row, uint64_t* ones,
+                                                                uint64_t* twos, int cols) {
+    int c = 1;
+    for (; c + 4 <= cols + 1; c += 4) {
+        __m256i w  = _mm256_loadu_si256((const __m256i*)(row + c - 1));
+        __m256i x  = _mm256_loadu_si256((const __m256i*)(row + c));
+        __m256i e  = _mm256_loadu_si256((const __m256i*)(row + c + 1));
+        __m256i we = w ^ e;
+        _mm256_storeu_si256((__m256i*)(ones + c), we ^ x);
+        _mm256_storeu_si256((__m256i*)(twos + c), (w & e) | (x & we));
+    }
+    for (; c <= cols; c++) {
+        uint64_t w = row[c - 1], x = row[c], e = row[c + 1], we = w ^ e;
+        ones[c] = we ^ x;
+        twos[c] = (w & e) | (x & we);
+    }
+}
+
+template <uint32_t Rule = LifeRule::conway().mask()>
+__attribute__((target("avx2"))) inline void stepEnsembleRowsAVX2(const uint64_t* prev, const uint64_t* snap,
+                                                                 const uint64_t* cur, uint64_t* next, int rows,
+                                                                 int cols, uint64_t* sums, uint32_t ruleMask,
+                                                                 uint64_t& changed, uint64_t& changed2,
+                                                                 uint64_t& changedSnap) {
+    const int stride  = cols + 2;
+    uint64_t* ones[3] = {sums, sums + 2 * stride, sums + 4 * stride};
+    uint64_t* twos[3] = {sums + stride, sums + 3 * stride, sums + 5 * stride};
+    __m256i diff1 = _mm256_setzero_si256(), diff2 = _mm256_setzero_si256(), diffSnap = _mm256_setzero_si256();
+    uint64_t tail1 = 0, tail2 = 0, tailSnap = 0;
+
+    ensembleRowSumsAVX2(cur, ones[0], twos[0], cols);
+    ensembleRowSumsAVX2(cur + stride, ones[1], twos[1], cols);
+
+    for (int r = 1; r <= rows; r++) {
+        ensembleRowSumsAVX2(cur + (size_t)(r + 1) * stride, ones[2], twos[2], cols);
+
+        const uint64_t* mid = cur + (size_t)r * stride;
+        const uint64_t* old = prev + (size_t)r * stride;
+        const uint64_t* was = snap + (size_t)r * stride;
+        uint64_t* out       = next + (size_t)r * stride;
+        const uint64_t *o0 = ones[0], *o1 = ones[1], *o2 = ones[2], *t0 = twos[0], *t1 = twos[1], *t2 = twos[2];
+        int c = 1;
+        for (; c + 4 <= cols + 1; c += 4) {
+            __m256i a1 = _mm256_loadu_si256((const __m256i*)(o0 + c));
+            __m256i b1 = _mm256_loadu_si256((const __m256i*)(o1 + c));
+            __m256i c1 = _mm256_loadu_si256((const __m256i*)(o2 + c));
+            __m256i a2 = _mm256_loadu_si256((const __m256i*)(t0 + c));
+            __m256i b2 = _mm256_loadu_si256((const __m256i*)(t1 + c));
+            __m256i c2 = _mm256_loadu_si256((const __m256i*)(t2 + c));
+            __m256i me = _mm256_loadu_si256((const __m256i*)(mid + c));
+            __m256i result;
+            summedWord<Rule>(result, a1, b1, c1, a2, b2, c2, me, ruleMask);
+            _mm256_storeu_si256((__m256i*)(out + c), result);
+            diff1 |= result ^ me;
+            diff2 |= result ^ _mm256_loadu_si256((const __m256i*)(old + c));
+            diffSnap |= result ^ _mm256_loadu_si256((const __m256i*)(was + c));
+        }
+        for (; c <= cols; c++) {
+            summedWord<Rule>(out[c], o0[c], o1[c], o2[c], t0[c], t1[c], t2[c], mid[c], ruleMask);
+            tail1 |= out[c] ^ mid[c];
+            tail2 |= out[c] ^ old[c];
+            tailSnap |= out[c] ^ was[c];
+        }
+
+        std::swap(ones[0], ones[1]);
+        std::swap(ones[1], ones[2]);
+        std::swap(twos[0], twos[1]);
+        std::swap(twos[1], twos[2]);
+    }
+
+    alignas(32) uint64_t lanes1[4], lanes2[4], lanesSnap[4];
+    _mm256_store_si256((__m256i*)lanes1, diff1);
+    _mm256_store_si256((__m256i*)lanes2, diff2);
+    _mm256_store_si256((__m256i*)lanesSnap, diffSnap);
+    changed     = tail1 | lanes1[0] | lanes1[1] | lanes1[2] | lanes1[3];
+    changed2    = tail2 | lanes2[0] | lanes2[1] | lanes2[2] | lanes2[3];
+    changedSnap = tailSnap | lanesSnap[0] | lanesSnap[1] | lanesSnap[2] | lanesSnap[3];
+}
+#endif
+
+// --------------------------------------------------------------
+// LifeEnsemble:
+// Many small, independent Life boards of the same size and rule
+// (e.g. thousands of 64x64 soups), stepped 64 at a time.
+//
+// Boards are grouped into batches of 64. A batch stores cell
+// (r, c) of all its boards in one uint64_t, bit k = board k, so
+// one ruleWord() call does the work of 64 separate boards and a
+// 64x64 board costs 64x fewer word operations than a ConwayLife
+// of its own. Batches are independent: with setThreads(n) they
+// are handed to n workers by work stealing.
+//
+// The kernel adds neighbor counts with bit-sliced row sums (AVX2
+// when the CPU has it, see stepEnsembleRows).
+//
+// Every generation each batch also learns which of its boards
+// stopped changing (period 1: still life or empty) or returned
+// to the board of two generations ago (period 2: blinkers and
+// other p2 oscillators). Any other cycle (pulsars, gliders going
+// round a toroidal board, ...) is found the way Brent's algorithm
+// does it: a snapshot of the batch is taken whenever its age is
+// a power of two, and each new generation is compared with it
+// lane by lane; a board that matches has the distance to the
+// snapshot as its period. Where such a cycle began is then found
+// by replaying the batch, from the snapshot before (or from its
+// first generation or last edit), next to a copy running
+// 'period' generations ahead (see findCycleStarts).
+//
+// A board that repeats is settled: settledAt() is the first
+// generation of its final cycle, settledPeriod() the period and
+// settledPopulation() its population there. run(maxGens) stops
+// each batch as soon as all its boards have settled. A cycle that
+// began after the last snapshot has not met one yet, so a batch
+// stopped at maxGens with boards unsettled also takes a snapshot
+// there and runs a copy up to maxGens generations past it (see
+// finishRun). Only boards still changing at maxGens, or whose
+// period is longer than maxGens, stay at -1.
+// --------------------------------------------------------------
+class LifeEnsemble {
+   public:
+    static constexpr int LANES = 64;  // boards per batch
+
+   private:
+    struct Batch {
+        std::vector<uint64_t> buffers[3];
+        std::vector<uint64_t> sums;       // row sums for the kernel (per batch, so threads never share)
+        int prev = 0, cur = 1, next = 2;  // buffer roles, rotated every generation
+        uint64_t lanes     = 0;           // bits of the boards this batch holds
+        uint64_t unsettled = 0;           // ... that have not settled yet
+        bool prevValid     = false;       // 'prev' is the generation before 'cur'
+        int generation     = 0;
+
+        // Cycle search (see above)
+        std::vector<uint64_t> origin;     // the boards at generation originGen
+        std::vector<uint64_t> snapshot;   // ... at generation snapGen
+        std::vector<uint64_t> older;      // ... and at olderGen, the snapshot before
+        std::vector<uint64_t> replay[4];  // two boards run side by side, two buffers each
+        int originGen = -1;               // -1: start over at the next step
+        int snapGen = 0, olderGen = -1;
+        uint64_t cycled = 0;              // boards with a known period, start of the cycle not found yet
+        int checkedAt   = -1;             // generation finishRun last ran at
+        int cyclePeriod[LANES] = {};
+    };
+
+    int boardCount, rows, cols, stride;
+    LifeRule rule;
+    SimdLevel level = detectSimdLevel();
+    Boundary boundary = Boundary::Dead;
+    std::vector<Batch> batches;
+
+    std::vector<int> settleGeneration;   // per board, -1 = not settled
+    std::vector<int> settlePeriod;       // length of the final cycle
+    std::vector<long long> settlePop;    // population at settleGeneration
+
+    int threads = 1;
+    std::unique_ptr<WorkStealingScheduler> scheduler;
+
+    uint64_t& word(std::vector<uint64_t>& buffer, int r, int c) {
+        return buffer[(size_t)(r + 1) * stride + (c + 1)];
+    }
+    uint64_t word(const std::vector<uint64_t>& buffer, int r, int c) const {
+        return buffer[(size_t)(r + 1) * stride + (c + 1)];
+    }
+
+    // Halo of one buffer from the boundary policy (all 64 boards
+    // share it). Dead / alive halos only need writing once.
+    void fillHalo(std::vector<uint64_t>& buffer, uint64_t lanes) {
+        if (isConstantBoundary(boundary)) {
+            uint64_t value = boundary == Boundary::Alive ? lanes : 0;
+            for (int c = -1; c <= cols; c++) word(buffer, -1, c) = word(buffer, rows, c) = value;
+            for (int r = 0; r < rows; r++) word(buffer, r, -1) = word(buffer, r, cols) = value;
+            return;
+        }
+        for (int r = 0; r < rows; r++) {
+            word(buffer, r, -1)   = word(buffer, r, haloSource(-1, cols, boundary));
+            word(buffer, r, cols) = word(buffer, r, haloSource(cols, cols, boundary));
+        }
+        for (int c = -1; c <= cols; c++) {
+            word(buffer, -1, c)   = word(buffer, haloSource(-1, rows, boundary), c);
+            word(buffer, rows, c) = word(buffer, haloSource(rows, rows, boundary), c);
+        }
+    }
+
+    // Population of every board in 'mask', from one buffer.
+    void countLanes(const std::vector<uint64_t>& buffer, uint64_t mask, long long* counts) const {
+        for (int r = 0; r < rows; r++)
+            for (int c = 0; c < cols; c++)
+                for (uint64_t bits = word(buffer, r, c) & mask; bits; bits &= bits - 1) counts[__builtin_ctzll(bits)]++;
+    }
+
+    // Record the boards in 'mask' as settled at 'generation'.
+    void settle(int index, uint64_t mask, int generation, int period, const std::vector<uint64_t>& buffer) {
+        long long counts[LANES] = {};
+        countLanes(buffer, mask, counts);
+        for (uint64_t bits = mask; bits; bits &= bits - 1) {
+            int lane  = __builtin_ctzll(bits);
+            int board = index * LANES + lane;
+            settleGeneration[board] = generation;
+            settlePeriod[board]     = period;
+            settlePop[board]        = counts[lane];
+        }
+        batches[index].unsettled &= ~mask;
+    }
+
+    // One generation cur -> next of batch 'index' (see stepEnsembleRows).
+    template <uint32_t Rule>
+    void stepBuffers(int index, const std::vector<uint64_t>& prev, const std::vector<uint64_t>& snap,
+                     std::vector<uint64_t>& cur, std::vector<uint64_t>& next, uint64_t& changed, uint64_t& changed2,
+                     uint64_t& changedSnap) {
+        Batch& b = batches[index];
+        if (!isConstantBoundary(boundary))
+            fillHalo(cur, b.lanes);
+#ifdef LIFE_X86_SIMD
+        if (level == SimdLevel::AVX2)
+            stepEnsembleRowsAVX2<Rule>(prev.data(), snap.data(), cur.data(), next.data(), rows, cols, b.sums.data(),
+                                       rule.mask(), changed, changed2, changedSnap);
+        else
+#endif
+            stepEnsembleRows<Rule>(prev.data(), snap.data(), cur.data(), next.data(), rows, cols, b.sums.data(),
+                                   rule.mask(), changed, changed2, changedSnap);
+    }
+
+    // Advance batch 'index' by 'gens' generations, but not past
+    // generation 'limit' (and, if 'untilSettled', not past the
+    // point where all of its boards have settled).
+    template <uint32_t Rule>
+    void advance(int index, int gens, int limit, bool untilSettled) {
+        Batch& b = batches[index];
+        for (int g = 0; g < gens && b.generation < limit && (b.unsettled || !untilSettled); g++) {
+            if (b.originGen < 0)
+                startCycleSearch(b);
+
+            uint64_t changed, changed2, changedSnap;
+            stepBuffers<Rule>(index, b.buffers[b.prev], b.snapshot, b.buffers[b.cur], b.buffers[b.next], changed,
+                              changed2, changedSnap);
+
+            // 'cur' (generation g) already repeats itself: period 1.
+            // 'next' equals 'prev': 'prev' (g - 1) starts a period-2 cycle.
+            uint64_t still = b.unsettled & ~changed;
+            if (still)
+                settle(index, still, b.generation, 1, b.buffers[b.cur]);
+            uint64_t blink = b.prevValid ? b.unsettled & ~changed2 : 0;
+            if (blink)
+                settle(index, blink, b.generation - 1, 2, b.buffers[b.prev]);
+
+            // 'next' equals the snapshot: a cycle of any other length
+            if (b.unsettled) {
+                int period     = b.generation + 1 - b.snapGen;
+                uint64_t again = b.unsettled & ~changedSnap;
+                for (uint64_t bits = again; bits; bits &= bits - 1) b.cyclePeriod[__builtin_ctzll(bits)] = period;
+                b.cycled |= again;
+                b.unsettled &= ~again;
+
+                // New snapshot at every power-of-two age; first settle
+                // what was found against the old one
+                int age = b.generation + 1 - b.originGen;
+                if (b.unsettled && !(age & (age - 1))) {
+                    if (b.cycled)
+                        findCycleStarts<Rule>(index);
+                    std::swap(b.older, b.snapshot);
+                    b.olderGen = b.snapGen;
+                    b.snapshot = b.buffers[b.next];
+                    b.snapGen  = b.generation + 1;
+                }
+            }
+
+            int oldPrev = b.prev;
+            b.prev      = b.cur;
+            b.cur       = b.next;
+            b.next      = oldPrev;
+            b.prevValid = true;
+            b.generation++;
+        }
+        if (b.cycled)
+            findCycleStarts<Rule>(index);
+        if (untilSettled && b.generation >= limit)
+            finishRun<Rule>(index, limit);
+    }
+
+    // The current generation becomes the origin and first snapshot.
+    static void startCycleSearch(Batch& b) {
+        b.origin    = b.buffers[b.cur];
+        b.snapshot  = b.origin;
+        b.originGen = b.snapGen = b.generation;
+        b.olderGen  = -1;
+    }
+
+    // ----------------------------------------------------------
+    // finishRun(index, gens): run() stopped batch 'index' at its
+    // limit. Its boards whose cycle began after the last snapshot
+    // have not met one, so the current generation becomes the
+    // snapshot (the old one 'older', which every generation since
+    // was compared with), a copy of the batch runs up to 'gens'
+    // generations ahead of it without moving the batch, and a
+    // board the copy comes back to has that distance as its
+    // period. findCycleStarts then finds where the cycle began.
+    // ----------------------------------------------------------
+    template <uint32_t Rule>
+    void finishRun(int index, int gens) {
+        Batch& b = batches[index];
+        if (!b.unsettled || (b.originGen >= 0 && b.checkedAt == b.generation))
+            return;
+        b.checkedAt = b.generation;
+        if (b.originGen < 0) {
+            startCycleSearch(b);
+        } else if (b.snapGen != b.generation) {
+            std::swap(b.older, b.snapshot);
+            b.olderGen = b.snapGen;
+            b.snapshot = b.buffers[b.cur];
+            b.snapGen  = b.generation;
+        }
+
+        b.replay[0] = b.replay[1] = b.snapshot;
+        uint64_t changed, changed2, changedSnap;
+        for (int g = 0; b.unsettled && g < gens; g++) {
+            stepBuffers<Rule>(index, b.snapshot, b.snapshot, b.replay[g & 1], b.replay[(g + 1) & 1], changed,
+                              changed2, changedSnap);
+            uint64_t again = b.unsettled & ~changedSnap;
+            for (uint64_t bits = again; bits; bits &= bits - 1) b.cyclePeriod[__builtin_ctzll(bits)] = g + 1;
+            b.cycled |= again;
+            b.unsettled &= ~again;
+        }
+        if (b.cycled)
+            findCycleStarts<Rule>(index);
+    }
+
+    // ----------------------------------------------------------
+    // findCycleStarts(index): settle the boards of b.cycled, which
+    // matched the current snapshot. For each period among them,
+    // run the batch from an earlier generation next to a copy
+    // 'period' generations ahead; a board's cycle starts at the
+    // first generation where the two agree (at the latest at
+    // snapGen). A cycle no longer than the gap between the older
+    // snapshot and this one would have matched the older one had
+    // it started by then, so the run can start there; otherwise
+    // it starts at 'origin'.
+    // ----------------------------------------------------------
+    template <uint32_t Rule>
+    void findCycleStarts(int index) {
+        Batch& b = batches[index];
+        while (b.cycled) {
+            int period     = b.cyclePeriod[__builtin_ctzll(b.cycled)];
+            uint64_t group = 0;
+            for (uint64_t bits = b.cycled; bits; bits &= bits - 1)
+                if (b.cyclePeriod[__builtin_ctzll(bits)] == period)
+                    group |= bits & -bits;
+            b.cycled &= ~group;
+
+            bool recent                     = b.olderGen >= 0 && period <= b.snapGen - b.olderGen;
+            const std::vector<uint64_t>& from = recent ? b.older : b.origin;
+            int fromGen                     = recent ? b.olderGen : b.originGen;
+
+            for (std::vector<uint64_t>& buffer : b.replay) buffer = from;
+            std::vector<uint64_t>* at[2]    = {&b.replay[0], &b.replay[1]};
+            std::vector<uint64_t>* ahead[2] = {&b.replay[2], &b.replay[3]};
+            uint64_t changed, changed2, changedSnap;
+            for (int g = 0; g < period; g++)  // the last step compares with 'from'
+                stepBuffers<Rule>(index, from, from, *ahead[g & 1], *ahead[(g + 1) & 1], changed, changed2,
+                                  changedSnap);
+            int lead = period & 1;
+
+            uint64_t left = group & changed2;
+            settle(index, group & ~changed2, fromGen, period, from);
+            for (int g = 0; left && fromGen + g < b.snapGen; g++) {
+                std::vector<uint64_t>& now  = *at[g & 1];
+                std::vector<uint64_t>& then = *at[(g + 1) & 1];
+                stepBuffers<Rule>(index, now, now, now, then, changed, changed2, changedSnap);
+                stepBuffers<Rule>(index, then, then, *ahead[(g + lead) & 1], *ahead[(g + lead + 1) & 1], changed,
+                                  changed2, changedSnap);
+                uint64_t found = left & ~changed2;
+                if (found)
+                    settle(index, found, fromGen + g + 1, period, then);
+                left &= changed2;
+            }
+        }
+    }
+
+    void advanceAll(int gens, int limit, bool untilSettled) {
+        dispatchRule(rule.mask(), [&](auto m) {
+            constexpr uint32_t Rule = decltype(m)::value;
+            if (scheduler && batches.size() > 1)
+                scheduler->run((int)batches.size(), [&](int i) { advance<Rule>(i, gens, limit, untilSettled); });
+            else
+                for (int i = 0; i < (int)batches.size(); i++) advance<Rule>(i, gens, limit, untilSettled);
+        });
+    }
+
+    void checkBoard(int board, int r, int c) const {
+        if (board < 0 || board >= boardCount || r < 0 || r >= rows || c < 0 || c >= cols)
+            throw std::invalid_argument("LifeEnsemble: cell out of range");
+    }
+
+    // An edited board starts over as unsettled.
+    void touched(int board) {
+        Batch& b = batches[board / LANES];
+        b.unsettled |= 1ull << (board % LANES);
+        b.prevValid = false;
+        b.originGen = -1;
+        settleGeneration[board] = -1;
+    }
+
+   public:
+    // ----------------------------------------------------------
+    // Constructor: 'boards' empty rows x cols boards.
+    // Throws std::invalid_argument for empty sizes.
+    // ----------------------------------------------------------
+    LifeEnsemble(int boards, int r, int c, const LifeRule& lifeRule = LifeRule::conway())
+        : boardCount(boards),
+          rows(r),
+          cols(c),
+          stride(c + 2),
+          rule(lifeRule),
+          batches((boards + LANES - 1) / LANES),
+          settleGeneration(boards, -1),
+          settlePeriod(boards, 0),
+          settlePop(boards, 0) {
+        if (boards <= 0 || r <= 0 || c <= 0)
+            throw std::invalid_argument("LifeEnsemble: boards, rows and cols must be positive");
+
+        for (size_t i = 0; i < batches.size(); i++) {
+            Batch& b  = batches[i];
+            int count = std::min(LANES, boards - (int)i * LANES);
+            b.lanes = b.unsettled = count == LANES ? ~0ull : (1ull << count) - 1;
+            for (std::vector<uint64_t>& buffer : b.buffers) buffer.assign((size_t)(r + 2) * stride, 0);
+            b.sums.assign((size_t)6 * stride, 0);
+        }
+    }
+
+    // ----------------------------------------------------------
+    // randomize(firstSeed, density):
+    // Board k becomes a random soup drawn from seed firstSeed + k
+    // (the same soup however the boards are batched or threaded).
+    // Restarts every board at generation 0.
+    // ----------------------------------------------------------
+    void randomize(uint64_t firstSeed, double density = 0.5) {
+        for (Batch& b : batches)
+            for (std::vector<uint64_t>& buffer : b.buffers) std::fill(buffer.begin(), buffer.end(), 0);
+
+        for (int board = 0; board < boardCount; board++) {
+            std::mt19937_64 rng(firstSeed + board);
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+            Batch& b     = batches[board / LANES];
+            uint64_t bit = 1ull << (board % LANES);
+            for (int r = 0; r < rows; r++)
+                for (int c = 0; c < cols; c++)
+                    if (uniform(rng) < density)
+                        word(b.buffers[b.cur], r, c) |= bit;
+        }
+        restart();
+    }
+
+    // Forget all settle results and call the current boards generation 0.
+    void restart() {
+        for (Batch& b : batches) {
+            b.unsettled  = b.lanes;
+            b.prevValid  = false;
+            b.generation = 0;
+            b.originGen  = -1;
+            for (std::vector<uint64_t>& buffer : b.buffers) fillHalo(buffer, b.lanes);
+        }
+        std::fill(settleGeneration.begin(), settleGeneration.end(), -1);
+    }
+
+    // Cell editing; throws std::invalid_argument when out of range.
+    int getCell(int board, int r, int c) const {
+        checkBoard(board, r, c);
+        const Batch& b = batches[board / LANES];
+        return (word(b.buffers[b.cur], r, c) >> (board % LANES)) & 1;
+    }
+    void setCell(int board, int r, int c, int value) {
+        checkBoard(board, r, c);
+        Batch& b     = batches[board / LANES];
+        uint64_t bit = 1ull << (board % LANES);
+        uint64_t& w  = word(b.buffers[b.cur], r, c);
+        w            = value ? w | bit : w & ~bit;
+        touched(board);
+    }
+
+    // Boundary policy for every board (dead by default).
+    void setBoundary(Boundary policy) {
+        boundary = policy;
+        for (Batch& b : batches) {
+            for (std::vector<uint64_t>& buffer : b.buffers) fillHalo(buffer, b.lanes);
+            b.originGen = -1;
+        }
+    }
+
+    // Batches are spread over n workers (work stealing).
+    void setThreads(int n) {
+        threads = std::max(1, n);
+        scheduler.reset();
+        if (threads > 1)
+            scheduler = std::make_unique<WorkStealingScheduler>(threads);
+    }
+
+    // ----------------------------------------------------------
+    // step(gens): every board advances exactly 'gens' generations.
+    // run(maxGens): every board advances until its whole batch
+    // has settled or has run maxGens generations in total.
+    // ----------------------------------------------------------
+    void step(int gens = 1) {
+        advanceAll(gens, INT_MAX, false);
+    }
+    void run(int maxGens) {
+        advanceAll(INT_MAX, maxGens, true);
+    }
+
+    // Results per board
+    int size() const {
+        return boardCount;
+    }
+    int generation(int board) const {
+        return batches[board / LANES].generation;
+    }
+    int settledAt(int board) const {  // -1 while still changing
+        return settleGeneration[board];
+    }
+    int settledPeriod(int board) const {  // cycle length once settled
+        return settleGeneration[board] < 0 ? 0 : settlePeriod[board];
+    }
+    long long settledPopulation(int board) const {
+        return settlePop[board];
+    }
+    long long population(int board) const {  // live cells now
+        long long counts[LANES] = {};
+        const Batch& b          = batches[board / LANES];
+        countLanes(b.buffers[b.cur], 1ull << (board % LANES), counts);
+        return counts[board % LANES];
+    }
+
+    void printStats(std::ostream& out) const {
+        int settled      = 0;
+        long long genSum = 0;
+        for (int board = 0; board < boardCount; board++)
+            if (settleGeneration[board] >= 0) {
+                settled++;
+                genSum += settleGeneration[board];
+            }
+        out << "ensemble: " << boardCount << " boards of " << rows << "x" << cols << " in " << batches.size()
+            << " batches of " << LANES << ", rule " << rule.toString() << ", kernel "
+            << (level == SimdLevel::AVX2 ? "avx2" : "scalar") << ", " << threads << " threads; " << settled
+            << " settled";
+        if (settled)
+            out << " (mean generation " << (double)genSum / settled << ")";
+        out << "\n";
+        if (scheduler)
+            scheduler->printStats(out);
+    }
+};
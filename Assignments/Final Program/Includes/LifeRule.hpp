@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// --------------------------------------------------------------
+// LifeRule:
+// An outer-totalistic "Life-like" rule, written B3/S23 for Conway:
+//
+//   birth   bit n set -> a dead cell with n live neighbors is born
+//   survive bit n set -> a live cell with n live neighbors survives
+//
+// mask() packs both into one 18-bit number, bit (9 * alive + n),
+// so the next state of a cell is a single shift:
+//
+//     next = (mask >> (9 * alive + neighbors)) & 1
+//
+// Engines that precompute tables (e.g. LookupEngine) build them
+// from a LifeRule, so a different rule gets its own table.
+// --------------------------------------------------------------
+struct LifeRule {
+    uint16_t birth;    // bits 0..8
+    uint16_t survive;  // bits 0..8
+
+    // Conway's Game of Life: B3/S23
+    //   1. A live cell with 2 or 3 neighbors survives.
+    //   2. A dead cell becomes alive if it has exactly 3 neighbors.
+    //   3. All other live cells die; all other dead cells stay dead.
+    static constexpr LifeRule conway() {
+        return LifeRule{1u << 3, (1u << 2) | (1u << 3)};
+    }
+
+    // HighLife: B36/S23 (Life plus a replicator)
+    static constexpr LifeRule highLife() {
+        return LifeRule{(1u << 3) | (1u << 6), (1u << 2) | (1u << 3)};
+    }
+
+    // Day & Night: B3678/S34678 (live and dead cells behave alike)
+    static constexpr LifeRule dayAndNight() {
+        return LifeRule{(1u << 3) | (1u << 6) | (1u << 7) | (1u << 8),
+                        (1u << 3) | (1u << 4) | (1u << 6) | (1u << 7) | (1u << 8)};
+    }
+
+    // Seeds: B2/S (every live cell dies)
+    static constexpr LifeRule seeds() {
+        return LifeRule{1u << 2, 0};
+    }
+
+    constexpr uint32_t mask() const {
+        return birth | ((uint32_t)survive << 9);
+    }
+
+    // Next state of one cell with 'neighbors' live neighbors.
+    constexpr bool next(bool alive, int neighbors) const {
+        return ((alive ? survive : birth) >> neighbors) & 1;
+    }
+
+    // Does a dead cell with no live neighbors come alive? Such
+    // rules need a bounded board (empty space is never stable).
+    constexpr bool bornFromNothing() const {
+        return birth & 1;
+    }
+
+    constexpr bool operator==(const LifeRule& other) const {
+        return birth == other.birth && survive == other.survive;
+    }
+
+    // "B36/S23"
+    std::string toString() const {
+        std::string text = "B";
+        for (int n = 0; n <= 8; n++)
+            if ((birth >> n) & 1)
+                text += char('0' + n);
+        text += "/S";
+        for (int n = 0; n <= 8; n++)
+            if ((survive >> n) & 1)
+                text += char('0' + n);
+        return text;
+    }
+
+    // ----------------------------------------------------------
+    // parse(text):
+    // Accepts "B36/S23" (any case, either order, '/' optional),
+    // the older "23/36" survive/birth form, and the names life,
+    // conway, highlife, daynight and seeds.
+    // Throws std::invalid_argument for anything else.
+    // ----------------------------------------------------------
+    static LifeRule parse(const std::string& text) {
+        std::string t;
+        for (char ch : text)
+            if (!std::isspace((unsigned char)ch))
+                t += (char)std::tolower((unsigned char)ch);
+
+        if (t == "life" || t == "conway")
+            return conway();
+        if (t == "highlife")
+            return highLife();
+        if (t == "daynight" || t == "day&night")
+            return dayAndNight();
+        if (t == "seeds")
+            return seeds();
+
+        LifeRule rule{0, 0};
+        bool letters = t.find('b') != std::string::npos || t.find('s') != std::string::npos;
+        uint16_t* field = letters ? nullptr : &rule.survive;  // "S/B" when there are no letters
+        int fields = 0;
+
+        for (char ch : t) {
+            if (ch == 'b' || ch == 's') {
+                field = ch == 'b' ? &rule.birth : &rule.survive;
+                fields++;
+            } else if (ch == '/') {
+                if (!letters)
+                    field = &rule.birth;
+            } else if (ch >= '0' && ch <= '8' && field) {
+                *field |= 1u << (ch - '0');
+            } else {
+                throw std::invalid_argument("Unknown rule: " + text);
+            }
+        }
+
+        size_t slashes = std::count(t.begin(), t.end(), '/');
+        if ((letters && fields != 2) || (!letters && slashes != 1) || slashes > 1)
+            throw std::invalid_argument("Unknown rule: " + text);
+        return rule;
+    }
+};
+
+// --------------------------------------------------------------
+// Compile-time rule specialization:
+// Kernels are templates on an 18-bit rule mask. The common rules
+// are instantiated with their mask as a constant, so the birth /
+// survival test folds into fixed instructions; every other rule
+// uses the RUNTIME_RULE instance, which reads the mask (or tables
+// built from it) at run time.
+//
+// dispatchRule(mask, pick) calls pick(std::integral_constant<
+// uint32_t, M>) with M = the matching hot mask or RUNTIME_RULE:
+//
+//     auto kernel = dispatchRule(rule.mask(), [](auto m) {
+//         return &lifeRowScalar<decltype(m)::value>;
+//     });
+// --------------------------------------------------------------
+constexpr uint32_t RUNTIME_RULE = 0xFFFFFFFFu;
+
+template <typename Pick>
+auto dispatchRule(uint32_t mask, Pick pick) {
+    switch (mask) {
+        case LifeRule::conway().mask():
+            return pick(std::integral_constant<uint32_t, LifeRule::conway().mask()>());
+        case LifeRule::highLife().mask():
+            return pick(std::integral_constant<uint32_t, LifeRule::highLife().mask()>());
+        case LifeRule::dayAndNight().mask():
+            return pick(std::integral_constant<uint32_t, LifeRule::dayAndNight().mask()>());
+        case LifeRule::seeds().mask():
+            return pick(std::integral_constant<uint32_t, LifeRule::seeds().mask()>());
+        default:
+            return pick(std::integral_constant<uint32_t, RUNTIME_RULE>());
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "LifeEngine.hpp"
+#include "LifeRule.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --------------------------------------------------------------
+// LookupEngine:
+// Produces four cells per table read.
+//
+// A 4x4 block of cells is packed into a 16-bit index; the table
+// holds the next state of the 2x2 block in its center:
+//
+//     index bit 4*i + j = block cell (i, j)      i, j = 0..3
+//     result bit 2*i + j = next state of (i+1, j+1)  i, j = 0..1
+//
+//     . . . .
+//     . X X .     X = the 2x2 cells written by one lookup
+//     . X X .
+//     . . . .
+//
+// The 64K-entry table (64 KB) is built from a LifeRule when the
+// engine is created, so every rule gets its own table.
+// --------------------------------------------------------------
+class LookupEngine : public LifeEngine {
+   private:
+    LifeRule rule;
+    std::vector<uint8_t> table;  // 65536 entries, 4 result bits each
+    std::vector<uint8_t> zeros;  // stands in for the row past the halo
+
+    // 4 cells of one row -> 4 bits (cell c-1 in bit 0)
+    static unsigned nibble(const uint8_t* row, int c) {
+        return row[c - 1] | (row[c] << 1) | (row[c + 1] << 2) | (row[c + 2] << 3);
+    }
+
+    // Same, for the last column of an odd-width board (4th cell = 0)
+    static unsigned tailNibble(const uint8_t* row, int c) {
+        return row[c - 1] | (row[c] << 1) | (row[c + 1] << 2);
+    }
+
+    void buildTable() {
+        table.assign(1 << 16, 0);
+
+        for (unsigned index = 0; index < (1u << 16); index++) {
+            auto cell = [&](int i, int j) { return (index >> (4 * i + j)) & 1; };
+
+            uint8_t result = 0;
+            for (int i = 1; i <= 2; i++) {
+                for (int j = 1; j <= 2; j++) {
+                    int n = 0;
+                    for (int di = -1; di <= 1; di++)
+                        for (int dj = -1; dj <= 1; dj++)
+                            if (di || dj)
+                                n += cell(i + di, j + dj);
+
+                    if (rule.next(cell(i, j), n))
+                        result |= 1 << (2 * (i - 1) + (j - 1));
+                }
+            }
+            table[index] = result;
+        }
+    }
+
+   public:
+    explicit LookupEngine(const LifeRule& r = LifeRule::conway()) : rule(r) {
+        buildTable();
+    }
+
+    const char* name() const override {
+        return "lookup";
+    }
+
+    // The table is read-only and 'zeros' per-instance scratch.
+    bool splitsIntoBands() const override {
+        return true;
+    }
+
+    void step(const GridView& src, uint8_t* dst) override {
+        int rows   = src.rowCount();
+        int cols   = src.colCount();
+        int stride = src.rowStride();
+
+        if ((int)zeros.size() < cols + 3)
+            zeros.assign(cols + 3, 0);
+
+        for (int r = 0; r < rows; r += 2) {
+            // Rows r-1 .. r+2. With an odd row count the last pair
+            // reaches past the halo; that row only affects output
+            // row r+1, which is not written, so zeros stand in.
+            bool pair           = r + 1 < rows;
+            const uint8_t* row0 = src[r - 1].begin();
+            const uint8_t* row1 = src[r].begin();
+            const uint8_t* row2 = src[r + 1].begin();
+            const uint8_t* row3 = pair ? src[r + 2].begin() : zeros.data() + 1;
+            uint8_t* out0       = dst + (ptrdiff_t)r * stride;
+            uint8_t* out1       = out0 + stride;
+
+            int c = 0;
+            for (; c + 1 < cols; c += 2) {
+                unsigned index = nibble(row0, c) | (nibble(row1, c) << 4) | (nibble(row2, c) << 8) |
+                                 (nibble(row3, c) << 12);
+                uint8_t next = table[index];
+
+                out0[c]     = next & 1;
+                out0[c + 1] = (next >> 1) & 1;
+                if (pair) {
+                    out1[c]     = (next >> 2) & 1;
+                    out1[c + 1] = (next >> 3) & 1;
+                }
+            }
+
+            // Odd column count: the last block's 4th column is past the halo
+            if (c < cols) {
+                unsigned index = tailNibble(row0, c) | (tailNibble(row1, c) << 4) | (tailNibble(row2, c) << 8) |
+                                 (tailNibble(row3, c) << 12);
+                uint8_t next   = table[index];
+
+                out0[c] = next & 1;
+                if (pair)
+                    out1[c] = (next >> 2) & 1;
+            }
+        }
+    }
+};
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// --------------------------------------------------------------
+// defaultThreadCount(): one worker per hardware thread (at least 1).
+// --------------------------------------------------------------
+inline int defaultThreadCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// --------------------------------------------------------------
+// bandStart(count, band, bands): first item of 'band' when
+// [0, count) is cut into 'bands' contiguous, nearly equal bands.
+// --------------------------------------------------------------
+inline int bandStart(int count, int band, int bands) {
+    return (int)((long long)count * band / bands);
+}
+
+// --------------------------------------------------------------
+// CpuPinning: which CPU each pool worker is bound to.
+//
+//   None     the scheduler decides (default)
+//   Compact  worker t on CPU t: fill one socket before the next
+//   Spread   workers evenly strided over all CPUs, so on a
+//            two-socket host half the bands land on each socket
+//
+// Pinned workers stay next to the memory they first touched.
+// --------------------------------------------------------------
+enum class CpuPinning { None, Compact, Spread };
+
+inline CpuPinning parseCpuPinning(const std::string& name) {
+    if (name == "none")
+        return CpuPinning::None;
+    if (name == "compact")
+        return CpuPinning::Compact;
+    if (name == "spread")
+        return CpuPinning::Spread;
+    throw std::invalid_argument("Unknown pinning: " + name + " (none, compact or spread)");
+}
+
+// CPU for worker t of 'threads' under 'policy' (-1 = unpinned).
+inline int pinnedCpu(CpuPinning policy, int t, int threads) {
+    int cpus = defaultThreadCount();
+    if (policy == CpuPinning::Compact)
+        return t % cpus;
+    if (policy == CpuPinning::Spread)
+        return (int)((long long)t * cpus / std::max(1, threads)) % cpus;
+    return -1;
+}
+
+// Bind 'thread' to one CPU; false if that is not possible here.
+inline bool pinThread(std::thread& thread, int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof set, &set) == 0;
+#else
+    (void)thread;
+    (void)cpu;
+    return false;
+#endif
+}
+
+// --------------------------------------------------------------
+// ThreadPool:
+// Runs loop bodies on 'threads' bands for work that repeats every
+// generation: the 'threads' - 1 workers are started once and then
+// wait on a condition variable between calls instead of being
+// created and joined each time.
+//
+// run(body) calls body(band) for every band 0 .. size()-1, band 0
+// on the calling thread, and returns once all bands are done, so
+// every call is a barrier. The body is used in place (never
+// copied), so run() does not allocate. split(count, body) cuts
+// [0, count) into size() contiguous bands (see bandStart) and
+// calls body(begin, end) once per non-empty band; bands never
+// overlap, so bodies that only write their own rows need no
+// locking.
+// --------------------------------------------------------------
+class ThreadPool {
+   private:
+    std::vector<std::thread> workers;
+    std::mutex lock;
+    std::condition_variable wake, finished;
+
+    // The current job (valid while 'pending' > 0)
+    void (*job)(void*, int) = nullptr;
+    void* body              = nullptr;
+    uint64_t round          = 0;  // bumped by every run()
+    int pending             = 0;  // workers not done with this round
+    bool stopping           = false;
+
+    void work(int band) {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> guard(lock);
+        for (;;) {
+            wake.wait(guard, [&] { return stopping || round != seen; });
+            if (stopping)
+                return;
+            seen = round;
+
+            guard.unlock();
+            job(body, band);
+            guard.lock();
+
+            if (--pending == 0)
+                finished.notify_one();
+        }
+    }
+
+   public:
+    explicit ThreadPool(int threads) {
+        threads = std::max(1, threads);
+        workers.reserve(threads - 1);
+        for (int t = 1; t < threads; t++) workers.emplace_back(&ThreadPool::work, this, t);
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const {
+        return (int)workers.size() + 1;
+    }
+
+    // ----------------------------------------------------------
+    // pin(policy): bind worker t (band t) to pinnedCpu(policy, t).
+    // Band 0 runs on the calling thread, which is left alone.
+    // Returns false if some worker could not be pinned.
+    // ----------------------------------------------------------
+    bool pin(CpuPinning policy) {
+        bool ok = true;
+        if (policy == CpuPinning::None)
+            return ok;
+        for (int t = 1; t < size(); t++) ok = pinThread(workers[t - 1], pinnedCpu(policy, t, size())) && ok;
+        return ok;
+    }
+
+    template <typename Body>
+    void run(Body&& bandBody) {
+        using BodyType = std::remove_reference_t<Body>;
+        if (workers.empty()) {
+            bandBody(0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            job     = [](void* b, int band) { (*static_cast<BodyType*>(b))(band); };
+            body    = (void*)&bandBody;
+            pending = (int)workers.size();
+            round++;
+        }
+        wake.notify_all();
+
+        bandBody(0);
+
+        std::unique_lock<std::mutex> guard(lock);
+        finished.wait(guard, [&] { return pending == 0; });
+    }
+
+    // body(begin, end) once per non-empty band of [0, count).
+    template <typename Body>
+    void split(int count, Body&& body) {
+        const int bands = size();
+        run([&](int band) {
+            int first = bandStart(count, band, bands), last = bandStart(count, band + 1, bands);
+            if (first < last)
+                body(first, last);
+        });
+    }
+};
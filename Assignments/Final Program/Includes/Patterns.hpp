@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CellularAutomaton.hpp"
+#include "json.hpp"
+#include <fstream>
+#include <string>
+
+// --------------------------------------------------------------
+// loadPatterns(path):
+// Reads a shapes.json file ({"shapes": {"glider": {"cells": ...}}}).
+// Returns an empty object if the file cannot be opened.
+// --------------------------------------------------------------
+inline nlohmann::json loadPatterns(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open())
+        return nlohmann::json::object();
+    return nlohmann::json::parse(file);
+}
+
+// --------------------------------------------------------------
+// stampPattern(model, patterns, name, centerRow, centerCol):
+// Turns on the cells of shape 'name' around (centerRow, centerCol).
+// Cells that fall outside the grid are skipped.
+// Returns false if the shape is not in 'patterns'.
+// --------------------------------------------------------------
+inline bool stampPattern(CellularAutomaton& model, const nlohmann::json& patterns, const std::string& name,
+                         int centerRow, int centerCol) {
+    if (!patterns.contains("shapes") || !patterns["shapes"].contains(name))
+        return false;
+
+    for (const auto& cell : patterns["shapes"][name]["cells"]) {
+        int r = centerRow + cell["y"].get<int>();
+        int c = centerCol + cell["x"].get<int>();
+        model.setCell(r, c, 1);
+    }
+    return true;
+}
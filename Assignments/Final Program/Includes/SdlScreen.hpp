@@ -15,8 +15,11 @@
 #pragma once
 
 #include <SDL2/SDL.h>
+#include <array>
 #include <vector>
 
+#include "CellularAutomaton.hpp"
+
 class SdlScreen {
 private:
     SDL_Window* window;
@@ -26,12 +29,28 @@ private:
     int windowHeight;
     int cellSize;
 
+    // Color of each cell state (index = cell byte). State 0 is
+    // the background and is not drawn.
+    std::array<SDL_Color, 256> palette;
+
 public:
     SdlScreen(int w, int h, int cell);
     ~SdlScreen();
 
-    // Draws the grid + alive cells
-    void render(const std::vector<std::vector<int>>& grid);
+    // Draws the grid + every non-zero cell in its palette color
+    void render(const GridView& grid);
+
+    // Colors for states 1, 2, ... (states past the list repeat
+    // the last color).
+    void setPalette(const std::vector<SDL_Color>& colors);
+
+    // Default colors for an automaton with 'states' states:
+    // state 1 light gray, later (dying) states fading out.
+    static std::vector<SDL_Color> fadePalette(int states);
+
+    // Continuous colormap for states 1..255 (e.g. Lenia's 0..1
+    // field as bytes): dark blue -> purple -> orange -> pale yellow.
+    static std::vector<SDL_Color> colormap();
 
     // Delay the frame (simple FPS limit)
     void pause(int ms);
@@ -0,0 +1,350 @@
+#pragma once
+
+#include "LifeEngine.hpp"
+#include "LifeRule.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LIFE_X86_SIMD 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+// --------------------------------------------------------------
+// SIMD instruction sets the byte kernel can use, best last.
+// --------------------------------------------------------------
+enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2:
+            return "avx2";
+        case SimdLevel::SSE2:
+            return "sse2";
+        default:
+            return "scalar";
+    }
+}
+
+// --------------------------------------------------------------
+// detectSimdLevel():
+// Asks the CPU (CPUID) which instruction sets it has. AVX2 also
+// needs the OS to save the YMM registers (OSXSAVE + XGETBV).
+// The answer is computed once and cached.
+// --------------------------------------------------------------
+inline SimdLevel detectSimdLevel() {
+    static const SimdLevel level = [] {
+        SimdLevel best = SimdLevel::Scalar;
+#ifdef LIFE_X86_SIMD
+        unsigned eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            return best;
+
+        if (edx & (1u << 26))  // SSE2
+            best = SimdLevel::SSE2;
+
+        bool osxsave = ecx & (1u << 27);
+        bool avx     = ecx & (1u << 28);
+        if (osxsave && avx) {
+            unsigned xcrLo, xcrHi;
+            __asm__("xgetbv" : "=a"(xcrLo), "=d"(xcrHi) : "c"(0));
+            bool ymmSaved = (xcrLo & 0x6) == 0x6;  // XMM + YMM state
+
+            if (ymmSaved && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & (1u << 5)))
+                best = SimdLevel::AVX2;
+        }
+#endif
+        return best;
+    }();
+    return level;
+}
+
+// --------------------------------------------------------------
+// RowRule:
+// What a row kernel needs to know about the rule: the 18-bit mask
+// (see LifeRule::mask), the same bits as two 16-byte tables,
+// indexed by the neighbor count, for byte-shuffle lookups, and as
+// a list of byte values to compare against (SSE2 has no shuffle).
+//
+// A cell's key is its count n, plus 16 if it is alive; 'keys'
+// lists the keys whose next state is 1. When more than 9 are,
+// it lists the ones giving 0 instead and keysFlip is 0xFF, so no
+// rule needs more than 9 compares.
+// --------------------------------------------------------------
+struct RowRule {
+    uint32_t mask;
+    uint8_t birth[16];    // birth[n]   = 1: a dead cell with n neighbors is born
+    uint8_t survive[16];  // survive[n] = 1: a live cell with n neighbors survives
+    uint8_t keys[9];
+    uint8_t keyCount;
+    uint8_t keysFlip;
+};
+
+constexpr RowRule makeRowRule(uint32_t mask) {
+    RowRule rule{mask, {}, {}, {}, 0, 0};
+    int ones = 0;
+    for (int n = 0; n <= 8; n++) {
+        rule.birth[n]   = (mask >> n) & 1;
+        rule.survive[n] = (mask >> (9 + n)) & 1;
+        ones += rule.birth[n] + rule.survive[n];
+    }
+
+    uint8_t wanted = ones > 9 ? 0 : 1;
+    rule.keysFlip  = ones > 9 ? 0xFF : 0;
+    for (int n = 0; n <= 8; n++) {
+        if (rule.birth[n] == wanted)
+            rule.keys[rule.keyCount++] = (uint8_t)n;
+        if (rule.survive[n] == wanted)
+            rule.keys[rule.keyCount++] = (uint8_t)(16 + n);
+    }
+    return rule;
+}
+
+inline RowRule makeRowRule(const LifeRule& rule) {
+    return makeRowRule(rule.mask());
+}
+
+// The rule a kernel instance applies: its template mask, or
+// 'runtime' for the RUNTIME_RULE instance.
+template <uint32_t Mask>
+const RowRule& kernelRule(const RowRule& runtime) {
+    static constexpr RowRule fixed = makeRowRule(Mask);
+    return Mask == RUNTIME_RULE ? runtime : fixed;
+}
+
+// --------------------------------------------------------------
+// Row kernels:
+// Compute one output row from three input rows. Each input row
+// is readable from index -1 through n (the halo), so no bounds
+// checks are needed. Cells are 0/1 bytes.
+//
+// Each kernel is a template on the rule mask (see dispatchRule).
+// Conway's rule has a branch-free special case: with n = live
+// neighbors,
+//     alive next  <=>  (n | self) == 3
+// because n | 1 == 3 only for n = 2 or 3, and n | 0 == 3 only for 3.
+// Other rules look the count up in the 16-byte tables (AVX2 byte
+// shuffle) or shift the mask (scalar), which costs the same for
+// every rule. SSE2 has no byte shuffle, so it compares against the
+// rule's keys: one compare per key, at most 9 (see RowRule), which
+// makes the densest rules about twice as slow as B3/S23.
+// --------------------------------------------------------------
+using LifeRowKernel = void (*)(const uint8_t* up, const uint8_t* mid, const uint8_t* down, uint8_t* out, int n,
+                               const RowRule& rule);
+
+constexpr uint32_t CONWAY_MASK = LifeRule::conway().mask();
+
+template <uint32_t Mask = CONWAY_MASK>
+inline void lifeRowScalar(const uint8_t* up, const uint8_t* mid, const uint8_t* down, uint8_t* out, int n,
+                          const RowRule& rule) {
+    const uint32_t mask = kernelRule<Mask>(rule).mask;
+
+    for (int c = 0; c < n; c++) {
+        int count = up[c - 1] + up[c] + up[c + 1] + mid[c - 1] + mid[c + 1] + down[c - 1] + down[c] + down[c + 1];
+        if constexpr (Mask == CONWAY_MASK)
+            out[c] = (count | mid[c]) == 3;
+        else
+            out[c] = (mask >> (9 * mid[c] + count)) & 1;
+    }
+}
+
+#ifdef LIFE_X86_SIMD
+// --------------------------------------------------------------
+// RuleKeysSSE2:
+// A RowRule's keys broadcast into registers once per row. next()
+// is a template on the key count, so its compares unroll and the
+// per-cell test is only the compares the rule needs (see RowRule);
+// withKeyCount(count, pick) picks that instance at run time, the
+// way dispatchRule picks a rule mask.
+// --------------------------------------------------------------
+struct RuleKeysSSE2 {
+    __m128i keys[9];
+    __m128i flip;
+
+    __attribute__((target("sse2"))) explicit RuleKeysSSE2(const RowRule& rule)
+        : flip(_mm_set1_epi8((char)rule.keysFlip)) {
+        for (int k = 0; k < rule.keyCount; k++) keys[k] = _mm_set1_epi8((char)rule.keys[k]);
+    }
+
+    // 0xFF where a cell with this count and 'alive' mask (0xFF /
+    // 0x00) is alive next generation.
+    template <int Count>
+    __attribute__((target("sse2"))) __m128i next(__m128i count, __m128i alive) const {
+        __m128i key = _mm_or_si128(count, _mm_and_si128(alive, _mm_set1_epi8(16)));
+        __m128i hit = _mm_setzero_si128();
+#pragma GCC unroll 9
+        for (int k = 0; k < Count; k++) hit = _mm_or_si128(hit, _mm_cmpeq_epi8(key, keys[k]));
+        return _mm_xor_si128(hit, flip);
+    }
+};
+
+template <typename Pick>
+auto withKeyCount(int count, Pick pick) {
+    switch (count) {
+        case 0: return pick(std::integral_constant<int, 0>());
+        case 1: return pick(std::integral_constant<int, 1>());
+        case 2: return pick(std::integral_constant<int, 2>());
+        case 3: return pick(std::integral_constant<int, 3>());
+        case 4: return pick(std::integral_constant<int, 4>());
+        case 5: return pick(std::integral_constant<int, 5>());
+        case 6: return pick(std::integral_constant<int, 6>());
+        case 7: return pick(std::integral_constant<int, 7>());
+        case 8: return pick(std::integral_constant<int, 8>());
+        default: return pick(std::integral_constant<int, 9>());
+    }
+}
+
+// The 16-cell blocks of a row; returns the first column not done.
+template <uint32_t Mask, int Keys>
+__attribute__((target("sse2"))) inline int lifeRowSSE2Blocks(const uint8_t* up, const uint8_t* mid,
+                                                             const uint8_t* down, uint8_t* out, int n,
+                                                             const RowRule& rule) {
+    const RuleKeysSSE2 keys(rule);
+    const __m128i three = _mm_set1_epi8(3);
+    const __m128i one   = _mm_set1_epi8(1);
+    int c               = 0;
+
+    for (; c + 16 <= n; c += 16) {
+        // Vertical sums for columns c-1, c, c+1 ...
+        __m128i left = _mm_add_epi8(_mm_add_epi8(_mm_loadu_si128((const __m128i*)(up + c - 1)),
+                                                 _mm_loadu_si128((const __m128i*)(mid + c - 1))),
+                                    _mm_loadu_si128((const __m128i*)(down + c - 1)));
+        __m128i self = _mm_loadu_si128((const __m128i*)(mid + c));
+        __m128i center =
+            _mm_add_epi8(_mm_loadu_si128((const __m128i*)(up + c)), _mm_loadu_si128((const __m128i*)(down + c)));
+        __m128i right = _mm_add_epi8(_mm_add_epi8(_mm_loadu_si128((const __m128i*)(up + c + 1)),
+                                                  _mm_loadu_si128((const __m128i*)(mid + c + 1))),
+                                     _mm_loadu_si128((const __m128i*)(down + c + 1)));
+
+        // ... then add them (the center column skips the cell itself)
+        __m128i count = _mm_add_epi8(_mm_add_epi8(left, center), right);
+        __m128i next;
+        if constexpr (Mask == CONWAY_MASK) {
+            next = _mm_and_si128(_mm_cmpeq_epi8(_mm_or_si128(count, self), three), one);
+        } else {
+            next = _mm_and_si128(keys.template next<Keys>(count, _mm_cmpeq_epi8(self, one)), one);
+        }
+        _mm_storeu_si128((__m128i*)(out + c), next);
+    }
+    return c;
+}
+
+template <uint32_t Mask = CONWAY_MASK>
+__attribute__((target("sse2"))) inline void lifeRowSSE2(const uint8_t* up, const uint8_t* mid, const uint8_t* down,
+                                                        uint8_t* out, int n, const RowRule& rule) {
+    const RowRule& r = kernelRule<Mask>(rule);
+    int c;
+    if constexpr (Mask == RUNTIME_RULE)
+        c = withKeyCount(r.keyCount, [&](auto keys) {
+            return lifeRowSSE2Blocks<Mask, decltype(keys)::value>(up, mid, down, out, n, r);
+        });
+    else
+        c = lifeRowSSE2Blocks<Mask, makeRowRule(Mask).keyCount>(up, mid, down, out, n, r);
+
+    lifeRowScalar<Mask>(up + c, mid + c, down + c, out + c, n - c, rule);
+}
+
+template <uint32_t Mask = CONWAY_MASK>
+__attribute__((target("avx2"))) inline void lifeRowAVX2(const uint8_t* up, const uint8_t* mid, const uint8_t* down,
+                                                        uint8_t* out, int n, const RowRule& rule) {
+    const RowRule& r     = kernelRule<Mask>(rule);
+    const __m256i three  = _mm256_set1_epi8(3);
+    const __m256i one    = _mm256_set1_epi8(1);
+    const __m256i birth  = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)r.birth));
+    const __m256i remain = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)r.survive));
+    int c                = 0;
+
+    for (; c + 32 <= n; c += 32) {
+        __m256i left = _mm256_add_epi8(_mm256_add_epi8(_mm256_loadu_si256((const __m256i*)(up + c - 1)),
+                                                       _mm256_loadu_si256((const __m256i*)(mid + c - 1))),
+                                       _mm256_loadu_si256((const __m256i*)(down + c - 1)));
+        __m256i self   = _mm256_loadu_si256((const __m256i*)(mid + c));
+        __m256i center = _mm256_add_epi8(_mm256_loadu_si256((const __m256i*)(up + c)),
+                                         _mm256_loadu_si256((const __m256i*)(down + c)));
+        __m256i right  = _mm256_add_epi8(_mm256_add_epi8(_mm256_loadu_si256((const __m256i*)(up + c + 1)),
+                                                         _mm256_loadu_si256((const __m256i*)(mid + c + 1))),
+                                         _mm256_loadu_si256((const __m256i*)(down + c + 1)));
+
+        __m256i count = _mm256_add_epi8(_mm256_add_epi8(left, center), right);
+        __m256i next;
+        if constexpr (Mask == CONWAY_MASK) {
+            next = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_or_si256(count, self), three), one);
+        } else {
+            // count is 0..8, so it indexes the 16-byte tables directly
+            next = _mm256_blendv_epi8(_mm256_shuffle_epi8(birth, count), _mm256_shuffle_epi8(remain, count),
+                                      _mm256_cmpeq_epi8(self, one));
+        }
+        _mm256_storeu_si256((__m256i*)(out + c), next);
+    }
+
+    lifeRowSSE2<Mask>(up + c, mid + c, down + c, out + c, n - c, rule);
+}
+#endif
+
+// Kernel for a given level (must be supported by this CPU) and rule.
+inline LifeRowKernel lifeRowKernel(SimdLevel level, const LifeRule& rule = LifeRule::conway()) {
+    return dispatchRule(rule.mask(), [level](auto m) -> LifeRowKernel {
+        constexpr uint32_t M = decltype(m)::value;
+#ifdef LIFE_X86_SIMD
+        if (level == SimdLevel::AVX2)
+            return lifeRowAVX2<M>;
+        if (level == SimdLevel::SSE2)
+            return lifeRowSSE2<M>;
+#endif
+        (void)level;
+        return lifeRowScalar<M>;
+    });
+}
+
+// --------------------------------------------------------------
+// SimdEngine:
+// Byte-per-cell engine that sums neighbors for 16 (SSE2) or 32
+// (AVX2) cells per instruction. The instruction set is chosen
+// from CPUID when the engine is built; "branchless" runs the same
+// branch-free rule one cell at a time.
+//
+// The kernels read the rows above and below, and the halo columns,
+// straight from the grid, so the board edges need no special case.
+// --------------------------------------------------------------
+class SimdEngine : public LifeEngine {
+   private:
+    SimdLevel level;
+    RowRule rule;
+    LifeRowKernel kernel;
+
+   public:
+    // Uses the best level the CPU supports.
+    explicit SimdEngine(const LifeRule& r = LifeRule::conway()) : SimdEngine(detectSimdLevel(), r) {
+    }
+
+    explicit SimdEngine(SimdLevel wanted, const LifeRule& r = LifeRule::conway())
+        : level(wanted), rule(makeRowRule(r)), kernel(lifeRowKernel(wanted, r)) {
+        if ((int)wanted > (int)detectSimdLevel())
+            throw std::invalid_argument(std::string("CPU does not support ") + simdLevelName(wanted));
+    }
+
+    // "scalar" already names the countNeighbors loop, so the
+    // scalar fallback of this engine is called "branchless".
+    const char* name() const override {
+        return level == SimdLevel::Scalar ? "branchless" : simdLevelName(level);
+    }
+
+    // Keeps nothing between calls, so any row band can be stepped alone.
+    bool splitsIntoBands() const override {
+        return true;
+    }
+
+    SimdLevel getLevel() const {
+        return level;
+    }
+
+    void step(const GridView& src, uint8_t* dst) override {
+        for (int r = 0; r < src.rowCount(); r++)
+            kernel(src[r - 1].begin(), src[r].begin(), src[r + 1].begin(), dst + (ptrdiff_t)r * src.rowStride(),
+                   src.colCount(), rule);
+    }
+};
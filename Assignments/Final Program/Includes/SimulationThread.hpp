@@ -0,0 +1,225 @@
+#pragma once
+
+#include "AllocCounter.hpp"
+#include "CellularAutomaton.hpp"
+#include "SpscQueue.hpp"
+#include "TripleBuffer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// --------------------------------------------------------------
+// Edit: one change to the board requested by the UI thread.
+// Applied by the simulation thread between generations; a group
+// sent with SimulationThread::edit(group, count), such as the
+// cells of a pattern stamp, is applied between the same two.
+// --------------------------------------------------------------
+struct Edit {
+    enum Kind : uint8_t {
+        Set,        // setCell(row, col, value)
+        Toggle,     // toggleCell(row, col)
+        Clear,      // clear()
+        Randomize,  // randomize(density)
+        Step,       // step() once (single-stepping while paused)
+        Stats       // printStats(std::cout)
+    };
+
+    Kind kind      = Set;
+    int row        = 0;
+    int col        = 0;
+    int value      = 0;
+    double density = 0;
+};
+
+// --------------------------------------------------------------
+// Frame: a finished generation, copied out of the model so the
+// renderer never reads cells the simulation is writing.
+// --------------------------------------------------------------
+struct Frame {
+    std::vector<uint8_t> cells;  // rows x cols, no halo
+    int rows             = 0;
+    int cols             = 0;
+    long long generation = 0;  // generations stepped so far
+
+    GridView view() const {
+        return GridView(cells.data(), rows, cols, cols);
+    }
+};
+
+// --------------------------------------------------------------
+// SimulationThread:
+// Steps a model on its own thread so a slow generation does not
+// stall the window, and a slow frame does not stall the model.
+//
+// Every frame period the thread applies the queued edits, steps
+// 'gensPerFrame' generations (unless paused), copies the grid
+// into a Frame and publishes it through a TripleBuffer. The UI
+// thread reads the newest Frame with latest(), which never
+// blocks, and sends edits through an SpscQueue instead of
+// touching the model. Nothing else may use the model while the
+// thread runs.
+//
+// With countAllocations(warmup), heap allocations this thread
+// makes while stepping are added up once 'warmup' frames have
+// gone by (per thread, so the renderer's do not mix in; a
+// model's own worker threads are left to alloc_bench).
+// --------------------------------------------------------------
+class SimulationThread {
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    CellularAutomaton& model;
+    int gensPerFrame;
+    Clock::duration period;
+
+    TripleBuffer<Frame> frames;
+    SpscQueue<Edit, 4096> edits;
+
+    std::atomic<bool> running{true};
+    std::atomic<bool> paused{false};
+    std::atomic<int> allocWarmup{-1};  // -1 = not counting
+    std::atomic<size_t> stepAllocs{0};
+    long long generation = 0;
+    int frame            = 0;
+
+    std::thread worker;  // started last, once everything above exists
+
+    void apply(const Edit& e) {
+        switch (e.kind) {
+            case Edit::Set:
+                model.setCell(e.row, e.col, e.value);
+                break;
+            case Edit::Toggle:
+                model.toggleCell(e.row, e.col);
+                break;
+            case Edit::Clear:
+                model.clear();
+                break;
+            case Edit::Randomize:
+                model.randomize(e.density);
+                break;
+            case Edit::Step:
+                model.step();
+                generation++;
+                break;
+            case Edit::Stats:
+                model.printStats(std::cout);
+                break;
+        }
+    }
+
+    // Copy the model's grid into the back slot and hand it over.
+    void publish() {
+        Frame& out    = frames.writeSlot();
+        GridView grid = model.getGrid();
+        out.rows      = grid.rowCount();
+        out.cols      = grid.colCount();
+        out.cells.resize((size_t)out.rows * out.cols);
+        for (int r = 0; r < out.rows; r++) std::copy(grid[r].begin(), grid[r].end(), &out.cells[(size_t)r * out.cols]);
+        out.generation = generation;
+        frames.publish();
+    }
+
+    void loop() {
+        Clock::time_point next = Clock::now();
+        while (running.load(std::memory_order_relaxed)) {
+            bool changed = false;
+            Edit e;
+            while (edits.pop(e)) {
+                apply(e);
+                changed = true;
+            }
+
+            if (!paused.load(std::memory_order_relaxed)) {
+                ThreadAllocationScope scope;
+                model.step(gensPerFrame);
+                size_t count = scope.count();
+
+                generation += gensPerFrame;
+                changed = true;
+
+                int warmup = allocWarmup.load(std::memory_order_relaxed);
+                if (warmup >= 0 && ++frame > warmup)
+                    stepAllocs.fetch_add(count, std::memory_order_relaxed);
+            }
+
+            if (changed)
+                publish();
+
+            // Keep the old pace (one batch per frame period); while
+            // paused, wake often so edits still show up promptly.
+            next += period;
+            Clock::time_point now = Clock::now();
+            if (paused.load(std::memory_order_relaxed))
+                next = now + std::chrono::milliseconds(2);
+            else if (next < now)
+                next = now;  // running behind: don't try to catch up
+            std::this_thread::sleep_until(next);
+        }
+    }
+
+   public:
+    // Publishes the model's current grid, then starts stepping.
+    SimulationThread(CellularAutomaton& m, int gens, int frameDelayMs)
+        : model(m), gensPerFrame(gens), period(std::chrono::milliseconds(frameDelayMs)) {
+        publish();
+        worker = std::thread([this] { loop(); });
+    }
+
+    ~SimulationThread() {
+        stop();
+    }
+
+    SimulationThread(const SimulationThread&)            = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    // Finish the current frame and join; the model is free again.
+    void stop() {
+        running = false;
+        if (worker.joinable())
+            worker.join();
+    }
+
+    // ----------------------------------------------------------
+    // UI-thread side. edit() returns false (dropping the edit) if
+    // thousands are already waiting; edit(group, count) sends
+    // edits that must land in the same generation (all or none).
+    // latest() returns the newest published frame, or the
+    // previous one again if nothing new is ready. Its reference
+    // stays valid until the next call.
+    // ----------------------------------------------------------
+    bool edit(const Edit& e) {
+        return edits.push(e);
+    }
+    bool edit(const Edit* group, size_t count) {
+        return edits.push(group, count);  // loop() drains the queue before stepping
+    }
+
+    const Frame& latest() {
+        frames.update();
+        return frames.readSlot();
+    }
+
+    void setPaused(bool p) {
+        paused = p;
+    }
+    bool isPaused() const {
+        return paused;
+    }
+
+    // Allocation check; read the totals after stop().
+    void countAllocations(int warmupFrames) {
+        allocWarmup = warmupFrames;
+    }
+    size_t stepAllocations() const {
+        return stepAllocs;
+    }
+    int framesStepped() const {
+        return frame;
+    }
+};
@@ -0,0 +1,961 @@
+#pragma once
+
+#include "LifeRule.hpp"
+#include "Parallel.hpp"
+#include "SimdEngine.hpp"
+#include "TemporalBlockEngine.hpp"
+#include "json.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// --------------------------------------------------------------
+// SoupBoard:
+// A bounded 256 x 256 Life board, one row = 4 uint64_t (bit b of
+// word k = column 64k + b). Everything outside is dead.
+//
+// Only rows top .. bottom can hold live cells (all others are
+// zero), so stepping, copying and scanning skip the empty part.
+// The last step also left the population and 'sides', which has
+// bit 0 set if column 0 is occupied and bit 63 for column 255.
+// --------------------------------------------------------------
+constexpr int SOUP_WORDS = 4;
+constexpr int SOUP_SIZE  = 64 * SOUP_WORDS;
+
+struct SoupBoard {
+    alignas(32) uint64_t rows[SOUP_SIZE][SOUP_WORDS] = {};
+    int top              = SOUP_SIZE;  // none when top > bottom
+    int bottom           = -1;
+    long long population = 0;
+    uint64_t sides       = 0;
+
+    bool empty() const {
+        return top > bottom;
+    }
+    // Touches the outermost rows or columns?
+    bool atEdge() const {
+        return top == 0 || bottom == SOUP_SIZE - 1 || sides;
+    }
+
+    int get(int r, int c) const {
+        return (rows[r][c >> 6] >> (c & 63)) & 1;
+    }
+    void set(int r, int c) {
+        rows[r][c >> 6] |= 1ull << (c & 63);
+        top    = std::min(top, r);
+        bottom = std::max(bottom, r);
+    }
+
+    void clear() {
+        for (int r = top; r <= bottom; r++) std::fill(rows[r], rows[r] + SOUP_WORDS, 0);
+        top        = SOUP_SIZE;
+        bottom     = -1;
+        population = 0;
+        sides      = 0;
+    }
+
+    // Recompute top, bottom, population and sides after edits.
+    void fit() {
+        int first = SOUP_SIZE, last = -1;
+        population = 0;
+        sides      = 0;
+        for (int r = top; r <= bottom; r++) {
+            uint64_t any = 0;
+            for (int k = 0; k < SOUP_WORDS; k++) {
+                any |= rows[r][k];
+                population += __builtin_popcountll(rows[r][k]);
+            }
+            if (any) {
+                first = std::min(first, r);
+                last  = r;
+                sides |= (rows[r][0] & 1) | (rows[r][SOUP_WORDS - 1] & 1ull << 63);
+            }
+        }
+        top    = first;
+        bottom = last;
+    }
+
+    // This board's cells inside 'mask' (rows of 'mask' only).
+    void copyMasked(const SoupBoard& from, const SoupBoard& mask) {
+        clear();
+        top    = mask.top;
+        bottom = mask.bottom;
+        for (int r = top; r <= bottom; r++)
+            for (int k = 0; k < SOUP_WORDS; k++) rows[r][k] = from.rows[r][k] & mask.rows[r][k];
+        fit();
+    }
+
+    // Same cells (inside 'mask', if given)?
+    bool sameCells(const SoupBoard& other, const SoupBoard* mask = nullptr) const {
+        int first = std::min(top, other.top), last = std::max(bottom, other.bottom);
+        if (mask) {
+            first = std::max(first, mask->top);
+            last  = std::min(last, mask->bottom);
+        }
+        for (int r = first; r <= last; r++)
+            for (int k = 0; k < SOUP_WORDS; k++) {
+                uint64_t diff = rows[r][k] ^ other.rows[r][k];
+                if (mask ? diff & mask->rows[r][k] : diff)
+                    return false;
+            }
+        return true;
+    }
+};
+
+// --------------------------------------------------------------
+// stepSoupBoard:
+// One generation of a SoupBoard, rows cur.top-1 .. cur.bottom+1
+// only (nothing else can change). Rows of 'next' still holding
+// an older generation outside that range are cleared.
+//
+// Same adder as stepSummedRows(): each row's horizontal sums
+// (two bit-planes, carried across the 4 words) are made once and
+// summedWord() adds up the three around a row; a rolling window
+// keeps just three rows of sums.
+//
+// The AVX2 version holds a whole row in one register.
+// --------------------------------------------------------------
+inline void soupStepBegin(const SoupBoard& cur, SoupBoard& next, int& lo, int& hi) {
+    lo = std::max(0, cur.top - 1);
+    hi = std::min(SOUP_SIZE - 1, cur.bottom + 1);
+    for (int r = next.top; r <= next.bottom; r++)
+        if (r < lo || r > hi)
+            std::fill(next.rows[r], next.rows[r] + SOUP_WORDS, 0);
+    next.top        = SOUP_SIZE;
+    next.bottom     = -1;
+    next.population = 0;
+    next.sides      = 0;
+}
+
+inline void soupRowSums(const SoupBoard& cur, int r, uint64_t* ones, uint64_t* twos) {
+    if (r < cur.top || r > cur.bottom) {
+        std::fill(ones, ones + SOUP_WORDS, 0);
+        std::fill(twos, twos + SOUP_WORDS, 0);
+        return;
+    }
+    const uint64_t* row = cur.rows[r];
+    for (int k = 0; k < SOUP_WORDS; k++) {
+        uint64_t x  = row[k];
+        uint64_t w  = x << 1 | (k > 0 ? row[k - 1] >> 63 : 0);
+        uint64_t e  = x >> 1 | (k < SOUP_WORDS - 1 ? row[k + 1] << 63 : 0);
+        uint64_t we = w ^ e;
+        ones[k]     = we ^ x;
+        twos[k]     = (w & e) | (x & we);
+    }
+}
+
+template <uint32_t Rule = LifeRule::conway().mask()>
+inline void stepSoupBoard(const SoupBoard& cur, SoupBoard& next, uint32_t ruleMask = Rule) {
+    int lo, hi;
+    soupStepBegin(cur, next, lo, hi);
+    if (cur.empty())
+        return;
+
+    uint64_t sums[3][2][SOUP_WORDS];  // rows r-1, r, r+1 (rotating) x ones/twos
+    int a = 0, b = 1, c = 2;
+    soupRowSums(cur, lo - 1, sums[a][0], sums[a][1]);
+    soupRowSums(cur, lo, sums[b][0], sums[b][1]);
+
+    for (int r = lo; r <= hi; r++) {
+        soupRowSums(cur, r + 1, sums[c][0], sums[c][1]);
+        uint64_t near = 0, any = 0;
+        for (int k = 0; k < SOUP_WORDS; k++)
+            near |= sums[a][0][k] | sums[b][0][k] | sums[c][0][k] | sums[a][1][k] | sums[b][1][k] | sums[c][1][k];
+        for (int k = 0; k < SOUP_WORDS && near; k++) {  // rows r-1 .. r+1 empty: nothing born (no B0)
+            uint64_t& out = next.rows[r][k];
+            summedWord<Rule>(out, sums[a][0][k], sums[b][0][k], sums[c][0][k], sums[a][1][k], sums[b][1][k],
+                             sums[c][1][k], cur.rows[r][k], ruleMask);
+            any |= out;
+            next.population += __builtin_popcountll(out);
+        }
+        if (any) {
+            next.top    = std::min(next.top, r);
+            next.bottom = r;
+            next.sides |= (next.rows[r][0] & 1) | (next.rows[r][SOUP_WORDS - 1] & 1ull << 63);
+        }
+        if (!near)
+            std::fill(next.rows[r], next.rows[r] + SOUP_WORDS, 0);
+        int oldA = a;
+        a        = b;
+        b        = c;
+        c        = oldA;
+    }
+}
+
+#ifdef LIFE_X86_SIMD
+static_assert(SOUP_WORDS == 4, "the AVX2 soup kernel keeps one row in one __m256i");
+
+__attribute__((target("avx2"), always_inline)) inline void soupRowSumsAVX2(const SoupBoard& cur, int r,
+                                                                          __m256i& ones, __m256i& twos) {
+    if (r < cur.top || r > cur.bottom) {
+        ones = twos = _mm256_setzero_si256();
+        return;
+    }
+    __m256i x    = _mm256_load_si256((const __m256i*)cur.rows[r]);
+    __m256i zero = _mm256_setzero_si256();
+    // Word k-1 (0 for k = 0) and word k+1 (0 for k = 3) in lane k
+    __m256i before = _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 3)), zero, 0x03);
+    __m256i after  = _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(0, 3, 2, 1)), zero, 0xC0);
+    __m256i w      = _mm256_slli_epi64(x, 1) | _mm256_srli_epi64(before, 63);
+    __m256i e      = _mm256_srli_epi64(x, 1) | _mm256_slli_epi64(after, 63);
+    __m256i we     = w ^ e;
+    ones           = we ^ x;
+    twos           = (w & e) | (x & we);
+}
+
+template <uint32_t Rule = LifeRule::conway().mask()>
+__attribute__((target("avx2"))) inline void stepSoupBoardAVX2(const SoupBoard& cur, SoupBoard& next,
+                                                              uint32_t ruleMask = Rule) {
+    int lo, hi;
+    soupStepBegin(cur, next, lo, hi);
+    if (cur.empty())
+        return;
+
+    __m256i a1, a2, b1, b2, c1, c2;
+    soupRowSumsAVX2(cur, lo - 1, a1, a2);
+    soupRowSumsAVX2(cur, lo, b1, b2);
+
+    for (int r = lo; r <= hi; r++) {
+        soupRowSumsAVX2(cur, r + 1, c1, c2);
+        __m256i near = a2 | b2 | c2 | a1 | b1 | c1;
+        if (_mm256_testz_si256(near, near)) {  // rows r-1 .. r+1 empty: nothing born (no B0)
+            _mm256_store_si256((__m256i*)next.rows[r], near);
+        } else {
+            __m256i me = _mm256_load_si256((const __m256i*)cur.rows[r]);
+            __m256i result;
+            summedWord<Rule>(result, a1, b1, c1, a2, b2, c2, me, ruleMask);
+            _mm256_store_si256((__m256i*)next.rows[r], result);
+            if (!_mm256_testz_si256(result, result)) {
+                const uint64_t* out = next.rows[r];
+                next.population += __builtin_popcountll(out[0]) + __builtin_popcountll(out[1]) +
+                                   __builtin_popcountll(out[2]) + __builtin_popcountll(out[3]);
+                next.top    = std::min(next.top, r);
+                next.bottom = r;
+                next.sides |= (out[0] & 1) | (out[3] & 1ull << 63);
+            }
+        }
+        a1 = b1;
+        a2 = b2;
+        b1 = c1;
+        b2 = c2;
+    }
+}
+#endif
+
+// --------------------------------------------------------------
+// floodFill(area, r, c, out, reach):
+// The cells of 'area' connected to (r, c), where two cells are
+// connected if they are at most 'reach' apart in both directions
+// (reach 1 = the usual 8 neighbors). Grows the region a ring at
+// a time, a whole row per operation.
+// --------------------------------------------------------------
+inline void floodFill(const SoupBoard& area, int r, int c, SoupBoard& out, int reach = 1) {
+    out.clear();
+    out.set(r, c);
+    for (bool grew = true; grew;) {
+        grew = false;
+        for (int i = std::max(area.top, out.top - reach); i <= std::min(area.bottom, out.bottom + reach); i++) {
+            uint64_t span[SOUP_WORDS] = {};
+            for (int j = std::max(0, i - reach); j <= std::min(SOUP_SIZE - 1, i + reach); j++)
+                for (int k = 0; k < SOUP_WORDS; k++) span[k] |= out.rows[j][k];
+            for (int step = 0; step < reach; step++) {
+                uint64_t wider[SOUP_WORDS];
+                for (int k = 0; k < SOUP_WORDS; k++)
+                    wider[k] = span[k] | span[k] << 1 | span[k] >> 1 | (k > 0 ? span[k - 1] >> 63 : 0) |
+                               (k < SOUP_WORDS - 1 ? span[k + 1] << 63 : 0);
+                std::copy(wider, wider + SOUP_WORDS, span);
+            }
+
+            bool added = false;
+            for (int k = 0; k < SOUP_WORDS; k++) {
+                uint64_t add = span[k] & area.rows[i][k] & ~out.rows[i][k];
+                out.rows[i][k] |= add;
+                added = added || add;
+            }
+            if (added) {
+                out.top    = std::min(out.top, i);
+                out.bottom = std::max(out.bottom, i);
+                grew       = true;
+            }
+        }
+    }
+    out.fit();
+}
+
+// --------------------------------------------------------------
+// Object codes, in the style of apgsearch's apgcodes:
+//
+//   xs<population>_<cells>   still life       (block:   xs4_33)
+//   xp<period>_<cells>       oscillator       (blinker: xp2_7)
+//   xq<period>_<cells>       spaceship        (glider:  xq4_153)
+//
+// <cells> is the "extended Wechsler format": the bounding box is
+// cut into strips of 5 rows; each column of a strip becomes one
+// digit 0-9a-v (bit i = row i of the strip), trailing zeros are
+// dropped, runs of zeros are shortened (w = 00, x = 000,
+// y0..yz = 4..39 zeros) and strips are joined by z.
+//
+// The code of an object is the shortest (then alphabetically
+// first) over all 8 rotations/reflections of all its phases, so
+// every phase and orientation gets the same name.
+// --------------------------------------------------------------
+using SoupCells = std::vector<std::pair<int, int>>;  // (row, col)
+
+// Live cells of a board, in row order.
+inline SoupCells cellsOf(const SoupBoard& board) {
+    SoupCells cells;
+    for (int r = board.top; r <= board.bottom; r++)
+        for (int k = 0; k < SOUP_WORDS; k++)
+            for (uint64_t bits = board.rows[r][k]; bits; bits &= bits - 1)
+                cells.emplace_back(r, 64 * k + __builtin_ctzll(bits));
+    return cells;
+}
+
+// Moved so the bounding box starts at (0, 0); returns the shift.
+inline std::pair<int, int> normalize(SoupCells& cells) {
+    int top = 1 << 30, left = 1 << 30;
+    for (auto [r, c] : cells) {
+        top  = std::min(top, r);
+        left = std::min(left, c);
+    }
+    for (auto& [r, c] : cells) {
+        r -= top;
+        c -= left;
+    }
+    return {top, left};
+}
+
+// Wechsler string of 'cells' in one of the 8 orientations
+// (bit 0 flips rows, bit 1 flips columns, bit 2 transposes).
+inline std::string wechslerCode(const SoupCells& cells, int orientation) {
+    static const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+    SoupCells points;
+    points.reserve(cells.size());
+    for (auto [r, c] : cells) {
+        int y = r, x = c;
+        if (orientation & 4)
+            std::swap(y, x);
+        points.emplace_back(orientation & 1 ? -y : y, orientation & 2 ? -x : x);
+    }
+    if (points.empty())
+        return "0";
+    normalize(points);
+
+    int height = 0, width = 0;
+    for (auto [y, x] : points) {
+        height = std::max(height, y + 1);
+        width  = std::max(width, x + 1);
+    }
+    int strips = (height + 4) / 5;
+    std::vector<uint8_t> strip((size_t)strips * width, 0);
+    for (auto [y, x] : points) strip[(size_t)(y / 5) * width + x] |= 1 << (y % 5);
+
+    std::string code;
+    for (int s = 0; s < strips; s++) {
+        if (s > 0)
+            code += 'z';
+        int zeros = 0;
+        for (int x = 0; x < width; x++) {
+            uint8_t column = strip[(size_t)s * width + x];
+            if (column == 0) {
+                zeros++;
+                continue;
+            }
+            for (; zeros >= 4; zeros -= std::min(zeros, 39)) {
+                code += 'y';
+                code += digits[std::min(zeros, 39) - 4];
+            }
+            if (zeros == 3)
+                code += 'x';
+            else if (zeros == 2)
+                code += 'w';
+            else if (zeros == 1)
+                code += '0';
+            zeros = 0;
+            code += digits[column];
+        }
+    }
+    return code;
+}
+
+inline std::string canonicalCode(const std::vector<SoupCells>& phases) {
+    std::string best;
+    for (const SoupCells& phase : phases)
+        for (int orientation = 0; orientation < 8; orientation++) {
+            std::string code = wechslerCode(phase, orientation);
+            if (best.empty() || code.size() < best.size() || (code.size() == best.size() && code < best))
+                best = code;
+        }
+    return best;
+}
+
+// --------------------------------------------------------------
+// SoupCensus:
+// What a number of soups left behind: how often each object code
+// turned up (and the first soup that had it), how many soups
+// stabilized, and how many did not (debris reached the edge of
+// the board, or no period was found within the generation limit).
+//
+// Each search thread fills its own census; merge() adds them up.
+// --------------------------------------------------------------
+struct SoupCensus {
+    struct Entry {
+        long long count  = 0;
+        long long sample = -1;  // first soup index that produced it
+    };
+
+    std::map<std::string, Entry> objects;
+    long long soups       = 0;
+    long long reachedEdge = 0;
+    long long unstable    = 0;
+    long long generations = 0;  // summed over all soups
+    long long stillLifes = 0, oscillators = 0, spaceships = 0;
+
+    void add(const std::string& code, long long soup) {
+        Entry& entry = objects[code];
+        if (entry.count++ == 0 || soup < entry.sample)
+            entry.sample = soup;
+        if (code[1] == 's')
+            stillLifes++;
+        else if (code[1] == 'p')
+            oscillators++;
+        else
+            spaceships++;
+    }
+
+    void merge(const SoupCensus& other) {
+        for (const auto& [code, theirs] : other.objects) {
+            Entry& entry = objects[code];
+            if (entry.count == 0 || theirs.sample < entry.sample)
+                entry.sample = theirs.sample;
+            entry.count += theirs.count;
+        }
+        soups += other.soups;
+        reachedEdge += other.reachedEdge;
+        unstable += other.unstable;
+        generations += other.generations;
+        stillLifes += other.stillLifes;
+        oscillators += other.oscillators;
+        spaceships += other.spaceships;
+    }
+
+    long long stabilized() const {
+        return soups - reachedEdge - unstable;
+    }
+
+    // Same results (what a different thread count must reproduce)?
+    bool operator==(const SoupCensus& other) const {
+        if (objects.size() != other.objects.size() || soups != other.soups || reachedEdge != other.reachedEdge ||
+            unstable != other.unstable || generations != other.generations)
+            return false;
+        for (const auto& [code, entry] : objects) {
+            auto it = other.objects.find(code);
+            if (it == other.objects.end() || it->second.count != entry.count || it->second.sample != entry.sample)
+                return false;
+        }
+        return true;
+    }
+
+    // Objects by count, most common first (ties by code).
+    std::vector<std::pair<std::string, Entry>> ranked() const {
+        std::vector<std::pair<std::string, Entry>> list(objects.begin(), objects.end());
+        std::stable_sort(list.begin(), list.end(),
+                         [](const auto& a, const auto& b) { return a.second.count > b.second.count; });
+        return list;
+    }
+
+    nlohmann::json toJson() const {
+        nlohmann::json out;
+        out["soups"]       = soups;
+        out["stabilized"]  = stabilized();
+        out["reachedEdge"] = reachedEdge;
+        out["unstable"]    = unstable;
+        out["generations"] = generations;
+        out["objects"]     = {{"stillLifes", stillLifes}, {"oscillators", oscillators}, {"spaceships", spaceships}};
+        out["census"]      = nlohmann::json::object();
+        out["samples"]     = nlohmann::json::object();
+        for (const auto& [code, entry] : objects) {
+            out["census"][code]  = entry.count;
+            out["samples"][code] = entry.sample;
+        }
+        return out;
+    }
+};
+
+// --------------------------------------------------------------
+// SoupSearch:
+// Random soups, run until they stabilize and taken apart into
+// objects (the idea of Adam Goucher's apgsearch, on a bounded
+// SoupBoard).
+//
+// Soup i is a soupSize x soupSize square (default 16x16, each
+// cell alive with probability 1/2, drawn from the seed and i
+// alone) in the middle of the board. Each generation:
+//
+//   * While nothing is on the outermost rows/columns, the board
+//     evolves exactly as on an infinite plane. When something
+//     gets there, its object is run on its own: if it becomes a
+//     spaceship it is counted and erased (it was leaving), if it
+//     dies it is erased; anything else ends the soup as
+//     'reachedEdge'.
+//   * Once the population has repeated with some period p for
+//     a while, the board is split into objects for period P =
+//     p, 2p, ... <= maxPeriod: cells 8-connected in the union of
+//     P+1 generations belong together; an object that does not
+//     evolve on its own exactly as in place for all P generations
+//     (part of a pseudo-object) is joined to the neighbors it
+//     interacts with until it does. Every object must be back in
+//     the same shape after P generations, in the same place
+//     (still life / oscillator) or moved (spaceship); if no P
+//     works, the soup runs on.
+//   * A soup that has not stabilized by maxGens is 'unstable'.
+//
+// Each object gets its own period (a divisor of P) and a code
+// (see canonicalCode) in the census.
+//
+// run(first, count) hands soups first .. first+count-1 to the
+// threads in chunks; every thread has its own boards and census,
+// merged when all are done, so the result does not depend on the
+// thread count.
+// --------------------------------------------------------------
+class SoupSearch {
+   public:
+    static constexpr int RING      = 64;  // periods up to RING - 1
+    static constexpr int CHUNK     = 64;  // soups handed to a thread at a time
+    static constexpr int TRANSIENT = 32;  // generations an object at the edge gets to become a spaceship
+
+   private:
+    // One thread's boards (about 600 KB; only the occupied rows are touched)
+    struct Worker {
+        SoupBoard main[2];
+        SoupBoard phase[RING + 1];  // a cycle being checked, or an object run on its own
+        SoupBoard scratch[3];
+        SoupBoard envelope, object;
+        SoupBoard near, piece;  // what isolate() joins to the object
+        long long pops[RING];  // population of generation g at g % RING
+        int streak[RING];      // generations in a row with pop(g) == pop(g - p)
+        std::vector<std::string> found;
+        SoupCensus census;
+    };
+
+    LifeRule rule;
+    int soupSize;
+    int maxGens     = 20000;
+    int maxPeriod   = 60;
+    uint64_t seed   = 1;
+    SimdLevel level = detectSimdLevel();
+    std::unique_ptr<ThreadPool> pool;
+
+    static uint64_t splitMix(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z          = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    template <uint32_t Rule>
+    void step(const SoupBoard& cur, SoupBoard& next) const {
+#ifdef LIFE_X86_SIMD
+        if (level == SimdLevel::AVX2) {
+            stepSoupBoardAVX2<Rule>(cur, next, rule.mask());
+            return;
+        }
+#endif
+        stepSoupBoard<Rule>(cur, next, rule.mask());
+    }
+
+    static bool firstCell(const SoupBoard& board, int& r, int& c) {
+        for (r = board.top; r <= board.bottom; r++)
+            for (int k = 0; k < SOUP_WORDS; k++)
+                if (board.rows[r][k]) {
+                    c = 64 * k + __builtin_ctzll(board.rows[r][k]);
+                    return true;
+                }
+        return false;
+    }
+
+    // A live cell on the outermost rows or columns, if any.
+    static bool edgeCell(const SoupBoard& board, int& r, int& c) {
+        for (r = board.top; r <= board.bottom; r++) {
+            bool outer = r == 0 || r == SOUP_SIZE - 1;
+            for (int k = 0; k < SOUP_WORDS; k++) {
+                uint64_t bits = board.rows[r][k];
+                if (!outer)
+                    bits &= (k == 0 ? 1ull : 0) | (k == SOUP_WORDS - 1 ? 1ull << 63 : 0);
+                if (bits) {
+                    c = 64 * k + __builtin_ctzll(bits);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // ----------------------------------------------------------
+    // escape(w, code): w.object just reached the edge. Run it on
+    // its own (centered in w.phase) for TRANSIENT generations,
+    // then up to maxPeriod more looking for its shape to come back
+    // somewhere else. Returns 1 with 'code' for a spaceship, 0 if
+    // it died, -1 for anything else.
+    // ----------------------------------------------------------
+    template <uint32_t Rule>
+    int escape(Worker& w, std::string& code) const {
+        SoupCells cells = cellsOf(w.object);
+        normalize(cells);
+        int height = 0, width = 0;
+        for (auto [r, c] : cells) {
+            height = std::max(height, r + 1);
+            width  = std::max(width, c + 1);
+        }
+        if (height > SOUP_SIZE / 4 || width > SOUP_SIZE / 4)
+            return -1;
+
+        SoupBoard* run = w.scratch;
+        run[0].clear();
+        for (auto [r, c] : cells) run[0].set(r + (SOUP_SIZE - height) / 2, c + (SOUP_SIZE - width) / 2);
+        run[0].fit();
+        for (int t = 0; t < TRANSIENT; t++) step<Rule>(run[t & 1], run[(t + 1) & 1]);  // ends in run[0]
+        if (run[0].empty())
+            return 0;
+
+        SoupBoard* phase = w.phase;
+        phase[0]         = run[0];
+        SoupCells start  = cellsOf(phase[0]);
+        auto origin      = normalize(start);
+        for (int p = 1; p <= maxPeriod; p++) {
+            step<Rule>(phase[p - 1], phase[p]);
+            if (phase[p].empty() || phase[p].atEdge())
+                return -1;
+            if (phase[p].population != phase[0].population)
+                continue;
+            SoupCells now = cellsOf(phase[p]);
+            if (normalize(now) == origin || now != start)
+                continue;  // in place, or another shape
+
+            std::vector<SoupCells> phases;
+            for (int k = 0; k < p; k++) phases.push_back(cellsOf(phase[k]));
+            code = "xq" + std::to_string(p) + "_" + canonicalCode(phases);
+            return 1;
+        }
+        return -1;
+    }
+
+    // The first generation k = 1 .. period at which w.object run
+    // on its own differs from its part of w.phase[k], with the two
+    // left in w.scratch[k & 1] and w.scratch[2]; 0 if there is
+    // none. Nonzero for part of a pseudo-object (it only lives
+    // that way with its neighbors).
+    template <uint32_t Rule>
+    int mismatch(Worker& w, int period) const {
+        SoupBoard* run = w.scratch;
+        run[0].copyMasked(w.phase[0], w.object);
+        for (int k = 1; k <= period; k++) {
+            step<Rule>(run[(k - 1) & 1], run[k & 1]);
+            run[2].copyMasked(w.phase[k], w.object);
+            if (!run[k & 1].sameCells(run[2]))
+                return k;
+        }
+        return 0;
+    }
+
+    // ----------------------------------------------------------
+    // isolate(w, r, c, period): w.object = the object of
+    // w.envelope holding (r, c). Starts from its 8-connected cells;
+    // while it does not evolve on its own as it does in place, a
+    // cell that came out different at generation k had a neighbor
+    // outside the object at k - 1, so the 8-connected pieces of
+    // those neighbors are joined and the run is tried again. Only
+    // neighbors that actually interact are joined (a pulsar's four
+    // quarters, not the still life next to it).
+    // ----------------------------------------------------------
+    template <uint32_t Rule>
+    void isolate(Worker& w, int r, int c, int period) const {
+        const SoupBoard& envelope = w.envelope;
+        SoupBoard& near           = w.near;
+        floodFill(envelope, r, c, w.object, 1);
+        for (int k; (k = mismatch<Rule>(w, period));) {
+            const SoupBoard& alone   = w.scratch[k & 1];
+            const SoupBoard& inPlace = w.scratch[2];
+            const SoupBoard& before  = w.phase[k - 1];
+
+            // Cells of generation k - 1 left in the envelope next to a difference
+            near.clear();
+            int lo = std::max(0, std::min(alone.top, inPlace.top) - 1);
+            int hi = std::min(SOUP_SIZE - 1, std::max(alone.bottom, inPlace.bottom) + 1);
+            for (int i = std::max(lo, before.top); i <= std::min(hi, before.bottom); i++) {
+                uint64_t diff[SOUP_WORDS] = {};
+                for (int j = std::max(lo, i - 1); j <= std::min(hi, i + 1); j++)
+                    for (int q = 0; q < SOUP_WORDS; q++) diff[q] |= alone.rows[j][q] ^ inPlace.rows[j][q];
+                for (int q = 0; q < SOUP_WORDS; q++) {
+                    uint64_t around = diff[q] | diff[q] << 1 | diff[q] >> 1 | (q > 0 ? diff[q - 1] >> 63 : 0) |
+                                      (q < SOUP_WORDS - 1 ? diff[q + 1] << 63 : 0);
+                    near.rows[i][q] = around & before.rows[i][q] & envelope.rows[i][q] & ~w.object.rows[i][q];
+                }
+                near.top    = std::min(near.top, i);
+                near.bottom = i;
+            }
+            near.fit();
+            if (near.empty())
+                return;  // only objects already taken out are involved
+
+            while (firstCell(near, r, c)) {
+                floodFill(envelope, r, c, w.piece, 1);
+                for (int i = w.piece.top; i <= w.piece.bottom; i++)
+                    for (int q = 0; q < SOUP_WORDS; q++) {
+                        w.object.rows[i][q] |= w.piece.rows[i][q];
+                        near.rows[i][q] &= ~w.piece.rows[i][q];
+                    }
+                w.object.top    = std::min(w.object.top, w.piece.top);
+                w.object.bottom = std::max(w.object.bottom, w.piece.bottom);
+                near.fit();
+            }
+            w.object.fit();
+        }
+    }
+
+    // ----------------------------------------------------------
+    // separate(w, period, soup): split the board in w.phase[0]
+    // into objects that all repeat (in place or moved) after
+    // 'period' generations (w.phase[0 .. period] are filled in);
+    // on success add them to the census. False (census untouched)
+    // if some part of the board does not repeat.
+    // ----------------------------------------------------------
+    template <uint32_t Rule>
+    bool separate(Worker& w, int period, long long soup) const {
+        SoupBoard* phase    = w.phase;
+        SoupBoard& envelope = w.envelope;
+        envelope.clear();
+        envelope.top    = std::max(0, phase[0].top - period);
+        envelope.bottom = std::min(SOUP_SIZE - 1, phase[0].bottom + period);
+        for (int k = 0; k <= period; k++)
+            for (int r = phase[k].top; r <= phase[k].bottom; r++)
+                for (int i = 0; i < SOUP_WORDS; i++) envelope.rows[r][i] |= phase[k].rows[r][i];
+        envelope.fit();
+
+        w.found.clear();
+        int r, c;
+        while (firstCell(envelope, r, c)) {
+            isolate<Rule>(w, r, c, period);
+            for (int i = w.object.top; i <= w.object.bottom; i++)
+                for (int k = 0; k < SOUP_WORDS; k++) envelope.rows[i][k] &= ~w.object.rows[i][k];
+            envelope.fit();
+
+            // Back in shape after 'period'? Then find its own period.
+            w.scratch[0].copyMasked(phase[0], w.object);
+            SoupCells start = cellsOf(w.scratch[0]);
+            auto origin     = normalize(start);
+            int own         = 0;
+            bool moved      = false;
+            for (int d = 1; d <= period && !own; d++) {
+                if (period % d)
+                    continue;
+                w.scratch[1].copyMasked(phase[d], w.object);
+                SoupCells now = cellsOf(w.scratch[1]);
+                auto where    = normalize(now);
+                if (now == start) {
+                    own   = d;
+                    moved = where != origin;
+                }
+            }
+            if (!own)
+                return false;
+
+            std::vector<SoupCells> phases;
+            for (int k = 0; k < own; k++) {
+                w.scratch[0].copyMasked(phase[k], w.object);
+                phases.push_back(cellsOf(w.scratch[0]));
+            }
+            std::string prefix = moved      ? "xq" + std::to_string(own)
+                                 : own == 1 ? "xs" + std::to_string(phases[0].size())
+                                            : "xp" + std::to_string(own);
+            w.found.push_back(prefix + "_" + canonicalCode(phases));
+        }
+
+        for (const std::string& code : w.found) w.census.add(code, soup);
+        return true;
+    }
+
+    // ----------------------------------------------------------
+    // stabilized(w, cur, p, soup): the population of 'cur' has
+    // repeated with period p for a while. Objects may still need
+    // a multiple of p (gliders and blinkers keep the population
+    // constant), so try period p, 2p, 3p, ... up to maxPeriod,
+    // giving up as soon as the population stops repeating.
+    // ----------------------------------------------------------
+    template <uint32_t Rule>
+    bool stabilized(Worker& w, const SoupBoard& cur, int p, long long soup) const {
+        SoupBoard* phase = w.phase;
+        phase[0]         = cur;
+        int stepped      = 0;
+        for (int period = p; period <= maxPeriod; period += p) {
+            for (; stepped < period; stepped++) {
+                step<Rule>(phase[stepped], phase[stepped + 1]);
+                if (stepped + 1 >= p && phase[stepped + 1].population != phase[stepped + 1 - p].population)
+                    return false;
+            }
+            if (separate<Rule>(w, period, soup))
+                return true;
+        }
+        return false;
+    }
+
+    // Run soup 'index' to the end and add it to w.census.
+    template <uint32_t Rule>
+    void runSoup(Worker& w, long long index) const {
+        SoupCensus& census = w.census;
+        census.soups++;
+
+        SoupBoard* cur  = &w.main[0];
+        SoupBoard* next = &w.main[1];
+        makeSoup(index, *cur);
+        next->clear();
+        int valid = 0;  // population history starts here
+        int retry = 0;  // next generation a stabilization check may run
+
+        for (int g = 0;; g++) {
+            // Something at the edge: spaceships leave, anything else ends the soup
+            if (cur->atEdge()) {
+                int r, c;
+                while (edgeCell(*cur, r, c)) {
+                    std::string code;
+                    floodFill(*cur, r, c, w.object, 1);
+                    int result = escape<Rule>(w, code);
+                    if (result < 0) {
+                        census.reachedEdge++;
+                        census.generations += g;
+                        return;
+                    }
+                    if (result > 0)
+                        census.add(code, index);
+                    for (int i = w.object.top; i <= w.object.bottom; i++)
+                        for (int k = 0; k < SOUP_WORDS; k++) cur->rows[i][k] &= ~w.object.rows[i][k];
+                    cur->fit();
+                }
+                valid = g;
+            }
+
+            // Smallest p the population has followed for 2p + 8 generations
+            int slot    = g % RING;
+            w.pops[slot] = cur->population;
+            int period  = 0;
+            for (int p = 1; p <= std::min(maxPeriod, g - valid); p++) {
+                w.streak[p] = w.pops[slot] == w.pops[(g - p) % RING] ? w.streak[p] + 1 : 0;
+                if (!period && w.streak[p] >= 2 * p + 8)
+                    period = p;
+            }
+            if (g - valid < maxPeriod)
+                w.streak[g - valid + 1] = 0;  // period first testable next generation
+
+            if (period && g >= retry) {
+                if (stabilized<Rule>(w, *cur, period, index)) {
+                    census.generations += g;
+                    return;
+                }
+                retry = g + 2 * period + 8;
+            }
+
+            if (g == maxGens) {
+                census.unstable++;
+                census.generations += g;
+                return;
+            }
+            step<Rule>(*cur, *next);
+            std::swap(cur, next);
+        }
+    }
+
+   public:
+    // ----------------------------------------------------------
+    // Constructor: soups of soupSize x soupSize under 'rule'.
+    // Throws std::invalid_argument for rules with B0 (the empty
+    // plane would not stay empty) and soup sizes outside 1..64.
+    // ----------------------------------------------------------
+    explicit SoupSearch(const LifeRule& lifeRule = LifeRule::conway(), int size = 16)
+        : rule(lifeRule), soupSize(size) {
+        if (rule.bornFromNothing())
+            throw std::invalid_argument("SoupSearch: rules with B0 are not supported");
+        if (size < 1 || size > 64)
+            throw std::invalid_argument("SoupSearch: soup size must be 1 .. 64");
+    }
+
+    void setSeed(uint64_t s) {
+        seed = s;
+    }
+    void setMaxGenerations(int gens) {
+        if (gens < 1)
+            throw std::invalid_argument("SoupSearch: maxGens must be positive");
+        maxGens = gens;
+    }
+    void setMaxPeriod(int period) {
+        if (period < 1 || period >= RING)
+            throw std::invalid_argument("SoupSearch: maxPeriod must be 1 .. " + std::to_string(RING - 1));
+        maxPeriod = period;
+    }
+    // n search threads (a persistent pool; 1 = the calling thread)
+    void setThreads(int n) {
+        n = std::max(1, n);
+        if (!pool || pool->size() != n)
+            pool = std::make_unique<ThreadPool>(n);
+    }
+
+    int threadCount() const {
+        return pool ? pool->size() : 1;
+    }
+    uint64_t getSeed() const {
+        return seed;
+    }
+    int getSoupSize() const {
+        return soupSize;
+    }
+    const LifeRule& getRule() const {
+        return rule;
+    }
+
+    // ----------------------------------------------------------
+    // makeSoup(index, board): the starting board of soup 'index'.
+    // Depends only on the seed and the index.
+    // ----------------------------------------------------------
+    void makeSoup(long long index, SoupBoard& board) const {
+        uint64_t state = seed * 0xD1B54A32D192ED03ull ^ (uint64_t)index * 0x9E3779B97F4A7C15ull;
+        uint64_t mask  = soupSize == 64 ? ~0ull : (1ull << soupSize) - 1;
+        int offset     = (SOUP_SIZE - soupSize) / 2;
+        board.clear();
+        for (int i = 0; i < soupSize; i++)
+            for (uint64_t bits = splitMix(state) & mask; bits; bits &= bits - 1)
+                board.set(offset + i, offset + __builtin_ctzll(bits));
+        board.fit();
+    }
+
+    // ----------------------------------------------------------
+    // run(first, count): search soups first .. first+count-1 and
+    // return their merged census.
+    // ----------------------------------------------------------
+    SoupCensus run(long long first, long long count) {
+        setThreads(threadCount());
+        std::vector<SoupCensus> tables(pool->size());
+        std::atomic<long long> next{first};
+        const long long end = first + count;
+
+        pool->run([&](int band) {
+            auto w = std::make_unique<Worker>();
+            dispatchRule(rule.mask(), [&](auto m) {
+                constexpr uint32_t Rule = decltype(m)::value;
+                for (long long start; (start = next.fetch_add(CHUNK)) < end;)
+                    for (long long i = start; i < std::min(end, start + CHUNK); i++) runSoup<Rule>(*w, i);
+            });
+            tables[band] = std::move(w->census);
+        });
+
+        SoupCensus total;
+        for (const SoupCensus& table : tables) total.merge(table);
+        return total;
+    }
+};
@@ -0,0 +1,264 @@
+#pragma once
+
+#include "BitPackedEngine.hpp"
+#include "UnboundedAutomaton.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+// --------------------------------------------------------------
+// SparseLife:
+// Life (or any Life-like rule without B0) on an unbounded plane, stored as 64x64 chunks in a
+// hash map keyed by chunk coordinates.
+//
+// Each chunk holds 64 rows of one uint64_t (bit c = column c), so a
+// whole chunk row advances with one ruleWord() call; the columns
+// past its left and right edges come from the neighboring chunks.
+//
+// Chunks exist only where there is life:
+//   - before a generation, an empty chunk is added next to every
+//     chunk with live cells on the shared edge (or corner), since
+//     only those cells can give birth across the edge
+//   - after a generation, chunks that became empty are freed
+// so the cost per generation follows the live area, and gliders
+// travel forever. Coordinates are 64-bit.
+//
+// The base-class grid is a viewport onto the universe (see
+// UnboundedAutomaton).
+// --------------------------------------------------------------
+class SparseLife : public UnboundedAutomaton {
+   private:
+    static constexpr int CHUNK = 64;
+
+    struct ChunkKey {
+        int64_t row, col;  // chunk coordinates (cell coordinate / 64)
+        bool operator==(const ChunkKey& other) const {
+            return row == other.row && col == other.col;
+        }
+    };
+
+    struct ChunkKeyHash {
+        size_t operator()(const ChunkKey& k) const {
+            uint64_t h = (uint64_t)k.row * 0x9E3779B97F4A7C15ULL ^ (uint64_t)k.col;
+            h *= 0xBF58476D1CE4E5B9ULL;
+            return (size_t)(h ^ (h >> 31));
+        }
+    };
+
+    // Two generations per chunk: bits[phase] is current.
+    struct Chunk {
+        uint64_t bits[2][CHUNK] = {};
+    };
+
+    std::unordered_map<ChunkKey, Chunk, ChunkKeyHash> chunks;
+    std::vector<ChunkKey> births;  // chunks to add before the next generation
+    int phase           = 0;
+    uint64_t generation = 0;
+
+    // Rule, and the stepChunk instance for it (see dispatchRule)
+    using ChunkStep   = void (SparseLife::*)(const ChunkKey&, Chunk&);
+    LifeRule rule     = LifeRule::conway();
+    ChunkStep stepper = &SparseLife::stepChunk<LifeRule::conway().mask()>;
+
+    static const uint64_t* zeros() {
+        static const uint64_t empty[CHUNK] = {};
+        return empty;
+    }
+
+    // Floor division / modulo by 64 (arithmetic shift on two's complement).
+    static int64_t chunkOf(int64_t v) {
+        return v >> 6;
+    }
+    static int bitOf(int64_t v) {
+        return (int)(v & (CHUNK - 1));
+    }
+
+    // Current rows of the chunk at 'key' (all zeros if absent).
+    const uint64_t* rowsOf(const ChunkKey& key) const {
+        auto found = chunks.find(key);
+        return found == chunks.end() ? zeros() : found->second.bits[phase];
+    }
+
+    void needChunk(int64_t row, int64_t col) {
+        ChunkKey key{row, col};
+        if (chunks.find(key) == chunks.end())
+            births.push_back(key);
+    }
+
+    // Add empty chunks next to live edges.
+    void addBorderChunks() {
+        births.clear();
+        for (const auto& entry : chunks) {
+            const ChunkKey& k   = entry.first;
+            const uint64_t* row = entry.second.bits[phase];
+
+            uint64_t left = 0, right = 0;
+            for (int r = 0; r < CHUNK; r++) {
+                left |= row[r] & 1;
+                right |= row[r] >> 63;
+            }
+            uint64_t top = row[0], bottom = row[CHUNK - 1];
+
+            if (top) needChunk(k.row - 1, k.col);
+            if (bottom) needChunk(k.row + 1, k.col);
+            if (left) needChunk(k.row, k.col - 1);
+            if (right) needChunk(k.row, k.col + 1);
+            if (top & 1) needChunk(k.row - 1, k.col - 1);
+            if (top >> 63) needChunk(k.row - 1, k.col + 1);
+            if (bottom & 1) needChunk(k.row + 1, k.col - 1);
+            if (bottom >> 63) needChunk(k.row + 1, k.col + 1);
+        }
+        for (const ChunkKey& key : births) chunks.try_emplace(key);
+    }
+
+    // --------------------------------------------------------------
+    // One generation for one chunk. Rows -1 and 64 come from the
+    // chunks above and below; bit -1 and bit 64 of every row from
+    // the chunks to the left and right.
+    // --------------------------------------------------------------
+    template <uint32_t Mask>
+    void stepChunk(const ChunkKey& k, Chunk& chunk) {
+        const uint64_t* nw = rowsOf({k.row - 1, k.col - 1});
+        const uint64_t* n  = rowsOf({k.row - 1, k.col});
+        const uint64_t* ne = rowsOf({k.row - 1, k.col + 1});
+        const uint64_t* w  = rowsOf({k.row, k.col - 1});
+        const uint64_t* me = chunk.bits[phase];
+        const uint64_t* e  = rowsOf({k.row, k.col + 1});
+        const uint64_t* sw = rowsOf({k.row + 1, k.col - 1});
+        const uint64_t* s  = rowsOf({k.row + 1, k.col});
+        const uint64_t* se = rowsOf({k.row + 1, k.col + 1});
+        uint64_t* out      = chunk.bits[phase ^ 1];
+
+        for (int r = 0; r < CHUNK; r++) {
+            // Row r-1, r, r+1 of this chunk column and its two neighbors
+            uint64_t a  = r > 0 ? me[r - 1] : n[CHUNK - 1];
+            uint64_t aL = r > 0 ? w[r - 1] : nw[CHUNK - 1];
+            uint64_t aR = r > 0 ? e[r - 1] : ne[CHUNK - 1];
+            uint64_t b = me[r], bL = w[r], bR = e[r];
+            uint64_t c  = r + 1 < CHUNK ? me[r + 1] : s[0];
+            uint64_t cL = r + 1 < CHUNK ? w[r + 1] : sw[0];
+            uint64_t cR = r + 1 < CHUNK ? e[r + 1] : se[0];
+
+            // West neighbor of column j is column j - 1 (see stepPackedRows)
+            out[r] = ruleWord<Mask>(rule.mask(), (a << 1) | (aL >> 63), a, (a >> 1) | (aR << 63),
+                                    (b << 1) | (bL >> 63), b, (b >> 1) | (bR << 63), (c << 1) | (cL >> 63), c,
+                                    (c >> 1) | (cR << 63));
+        }
+    }
+
+    void stepOnce() {
+        addBorderChunks();
+        for (auto& entry : chunks) (this->*stepper)(entry.first, entry.second);
+        phase ^= 1;
+
+        // Free chunks with no live cells
+        for (auto it = chunks.begin(); it != chunks.end();) {
+            const uint64_t* row = it->second.bits[phase];
+            uint64_t any        = 0;
+            for (int r = 0; r < CHUNK; r++) any |= row[r];
+            it = any ? std::next(it) : chunks.erase(it);
+        }
+        generation++;
+    }
+
+   protected:
+    void drawRegion(int64_t top, int64_t left, int rowCount, int colCount, uint8_t* out, int outStride) const override {
+        auto drawChunk = [&](const ChunkKey& k, const uint64_t* row) {
+            int64_t r0 = std::max(top, k.row * CHUNK), r1 = std::min(top + rowCount, (k.row + 1) * CHUNK);
+            int64_t c0 = std::max(left, k.col * CHUNK), c1 = std::min(left + colCount, (k.col + 1) * CHUNK);
+            for (int64_t r = r0; r < r1; r++)
+                for (int64_t c = c0; c < c1; c++)
+                    out[(r - top) * outStride + (c - left)] = (row[bitOf(r)] >> bitOf(c)) & 1;
+        };
+
+        int64_t firstRow = chunkOf(top), lastRow = chunkOf(top + rowCount - 1);
+        int64_t firstCol = chunkOf(left), lastCol = chunkOf(left + colCount - 1);
+
+        // Look up the chunks under the region, or scan the map if that is fewer
+        if ((uint64_t)(lastRow - firstRow + 1) * (uint64_t)(lastCol - firstCol + 1) <= chunks.size()) {
+            for (int64_t cr = firstRow; cr <= lastRow; cr++)
+                for (int64_t cc = firstCol; cc <= lastCol; cc++) {
+                    auto found = chunks.find({cr, cc});
+                    if (found != chunks.end())
+                        drawChunk(found->first, found->second.bits[phase]);
+                }
+        } else {
+            for (const auto& entry : chunks)
+                if (entry.first.row >= firstRow && entry.first.row <= lastRow && entry.first.col >= firstCol &&
+                    entry.first.col <= lastCol)
+                    drawChunk(entry.first, entry.second.bits[phase]);
+        }
+    }
+
+   public:
+    // 'r' x 'c' viewport over an empty universe.
+    SparseLife(int r, int c) : UnboundedAutomaton(r, c) {
+    }
+
+    void step() override {
+        importEdits();
+        stepOnce();
+        exportViewport();
+    }
+
+    // Several generations; the viewport is only refreshed at the end.
+    void step(int gens) override {
+        importEdits();
+        for (int g = 0; g < gens; g++) stepOnce();
+        exportViewport();
+    }
+
+    uint8_t getUniverseCell(int64_t row, int64_t col) const override {
+        return (rowsOf({chunkOf(row), chunkOf(col)})[bitOf(row)] >> bitOf(col)) & 1;
+    }
+
+    void setUniverseCell(int64_t row, int64_t col, uint8_t state) override {
+        ChunkKey key{chunkOf(row), chunkOf(col)};
+        auto found = chunks.find(key);
+        if (found == chunks.end()) {
+            if (!state)
+                return;
+            found = chunks.try_emplace(key).first;
+        }
+
+        uint64_t& word = found->second.bits[phase][bitOf(row)];
+        uint64_t bit   = (uint64_t)1 << bitOf(col);
+        word           = state ? (word | bit) : (word & ~bit);
+    }
+
+    // Any Life-like rule except B0 rules, which would fill the
+    // infinite plane at once (throws std::invalid_argument).
+    void setRule(const LifeRule& r) {
+        if (r.bornFromNothing())
+            throw std::invalid_argument("B0 rules need a bounded board: " + r.toString());
+        rule    = r;
+        stepper = dispatchRule(r.mask(), [](auto m) -> ChunkStep { return &SparseLife::stepChunk<decltype(m)::value>; });
+    }
+    const LifeRule& getRule() const {
+        return rule;
+    }
+
+    uint64_t getGeneration() const {
+        return generation;
+    }
+
+    uint64_t getPopulation() const {
+        uint64_t population = 0;
+        for (const auto& entry : chunks)
+            for (uint64_t row : entry.second.bits[phase]) population += __builtin_popcountll(row);
+        return population;
+    }
+
+    size_t chunkCount() const {
+        return chunks.size();
+    }
+
+    void printStats(std::ostream& out) const override {
+        out << "sparse: rule " << rule.toString() << ", generation " << generation << ", population " << getPopulation() << ", " << chunks.size()
+            << " chunks (" << chunks.size() * sizeof(Chunk) / 1024 << " KB)\n";
+    }
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// --------------------------------------------------------------
+// SpscQueue<T, Capacity>:
+// Lock-free FIFO for exactly one producer thread and one
+// consumer thread, in a fixed ring of Capacity slots (a power of
+// two), so neither push() nor pop() allocates or blocks.
+//
+// 'tail' is only written by the producer and 'head' only by the
+// consumer; each publishes its slot with a release store that
+// the other side reads with acquire. push() returns false when
+// the ring is full (the caller decides whether to drop or retry).
+//
+// push(items, count) publishes several items with one store, so
+// the consumer sees all of them or none: a pop() loop that runs
+// until the queue is empty never stops inside the group.
+// --------------------------------------------------------------
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+   private:
+    std::array<T, Capacity> items;
+    alignas(64) std::atomic<size_t> head{0};  // next slot to pop (consumer)
+    alignas(64) std::atomic<size_t> tail{0};  // next slot to push (producer)
+
+   public:
+    // Producer side
+    bool push(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity)
+            return false;
+        items[t & (Capacity - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // All 'count' items, or none (returns false) if they don't fit.
+    bool push(const T* group, size_t count) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (Capacity - (t - head.load(std::memory_order_acquire)) < count)
+            return false;
+        for (size_t i = 0; i < count; i++) items[(t + i) & (Capacity - 1)] = group[i];
+        tail.store(t + count, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+            return false;
+        item = items[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
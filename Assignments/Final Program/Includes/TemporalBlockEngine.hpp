@@ -0,0 +1,413 @@
+#pragma once
+
+#include "BitPackedEngine.hpp"
+#include "LifeEngine.hpp"
+#include "LifeRule.hpp"
+#include "SimdEngine.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// --------------------------------------------------------------
+// stepSummedRows<Rule>:
+// stepPackedRows() for a tile that sits in L1, with the same
+// layout (rows 1..rows of 'cur' computed, words past either end
+// read as 0) but a cheaper count.
+//
+// Each cell's 3x3 count is split into three horizontal sums, one
+// per row, of 0..3 (two bit-planes). A row's horizontal sum is
+// needed by the three output rows around it, so it is computed
+// once and kept in 'sums' (3 rows x 2 planes x 'words') while
+// the rows roll past. The three sums are then added into the
+// full 3x3 count S (0..9, the cell included):
+//
+//     birth n:   ~alive & S == n
+//     survive n:  alive & S == n + 1
+//
+// The AVX2 version does 4 words (256 cells) per instruction.
+// --------------------------------------------------------------
+
+// Horizontal sum of word k: cells to the left, the cell, to the right.
+inline void rowSumWord(const uint64_t* row, int k, int words, uint64_t* ones, uint64_t* twos) {
+    uint64_t x  = row[k];
+    uint64_t w  = (x << 1) | (k > 0 ? row[k - 1] >> 63 : 0);
+    uint64_t e  = (x >> 1) | (k + 1 < words ? row[k + 1] << 63 : 0);
+    uint64_t we = w ^ e;
+    ones[k]     = we ^ x;
+    twos[k]     = (w & e) | (x & we);
+}
+
+// ----------------------------------------------------------
+// summedWord<Rule>(out, ...): next state from the three
+// horizontal sums. Word is uint64_t or, inside the AVX2 kernel,
+// __m256i (GCC applies & | ^ ~ to vector types lane by lane);
+// everything is passed by reference so no AVX value crosses a
+// call boundary of this generic function.
+// ----------------------------------------------------------
+template <uint32_t Rule, typename Word>
+__attribute__((always_inline)) inline void summedWord(Word& out, const Word& a1, const Word& b1, const Word& c1,
+                                                      const Word& a2, const Word& b2, const Word& c2, const Word& me,
+                                                      uint32_t ruleMask) {
+    // Ones column: full adder; its carry joins the twos
+    Word ab    = a1 ^ b1;
+    Word s1    = ab ^ c1;
+    Word carry = (a1 & b1) | (c1 & ab);
+
+    // Four twos-bits -> s2, s4, s8
+    Word p  = a2 ^ b2, q = c2 ^ carry;
+    Word s2 = p ^ q;
+    Word s4 = (a2 & b2) ^ (c2 & carry) ^ (p & q);
+    Word s8 = a2 & b2 & c2 & carry;
+
+    if constexpr (Rule == LifeRule::conway().mask()) {
+        (void)ruleMask;
+        out = ~s8 & ((s1 & s2 & ~s4) | (me & ~s1 & ~s2 & s4));  // S == 3, or alive and S == 4
+    } else {
+        if constexpr (Rule != RUNTIME_RULE)
+            ruleMask = Rule;
+        Word born = me ^ me, keep = me ^ me;  // zero of either type
+#pragma GCC unroll 10
+        for (int n = 0; n <= 9; n++) {
+            Word is = ((n & 1) ? s1 : ~s1) & ((n & 2) ? s2 : ~s2) & ((n & 4) ? s4 : ~s4) & ((n & 8) ? s8 : ~s8);
+            if (n <= 8 && ((ruleMask >> n) & 1))
+                born |= is;
+            if (n >= 1 && ((ruleMask >> (9 + n - 1)) & 1))
+                keep |= is;
+        }
+        out = (born & ~me) | (keep & me);
+    }
+}
+
+template <uint32_t Rule = LifeRule::conway().mask()>
+inline void stepSummedRows(const uint64_t* cur, uint64_t* next, int rows, int words, uint64_t* sums,
+                           uint32_t ruleMask = Rule) {
+    uint64_t* ones[3] = {sums, sums + 2 * words, sums + 4 * words};  // rows r-1, r, r+1 (rotating)
+    uint64_t* twos[3] = {sums + words, sums + 3 * words, sums + 5 * words};
+
+    for (int k = 0; k < words; k++) rowSumWord(cur, k, words, ones[0], twos[0]);
+    for (int k = 0; k < words; k++) rowSumWord(cur + words, k, words, ones[1], twos[1]);
+
+    for (int r = 1; r <= rows; r++) {
+        const uint64_t* below = cur + (size_t)(r + 1) * words;
+        for (int k = 0; k < words; k++) rowSumWord(below, k, words, ones[2], twos[2]);
+
+        const uint64_t *mid = cur + (size_t)r * words, *o0 = ones[0], *o1 = ones[1], *o2 = ones[2];
+        const uint64_t *t0 = twos[0], *t1 = twos[1], *t2 = twos[2];
+        uint64_t* out = next + (size_t)r * words;
+        for (int k = 0; k < words; k++)
+            summedWord<Rule>(out[k], o0[k], o1[k], o2[k], t0[k], t1[k], t2[k], mid[k], ruleMask);
+
+        std::swap(ones[0], ones[1]);
+        std::swap(ones[1], ones[2]);
+        std::swap(twos[0], twos[1]);
+        std::swap(twos[1], twos[2]);
+    }
+}
+
+#ifdef LIFE_X86_SIMD
+__attribute__((target("avx2"))) inline void rowSumsAVX2(const uint64_t* row, uint64_t* ones, uint64_t* twos,
+                                                        int words) {
+    rowSumWord(row, 0, words, ones, twos);
+    int k = 1;
+    for (; k + 5 <= words; k += 4) {  // words k-1 .. k+4 are all inside the row
+        __m256i x  = _mm256_loadu_si256((const __m256i*)(row + k));
+        __m256i w  = _mm256_or_si256(_mm256_slli_epi64(x, 1),
+                                     _mm256_srli_epi64(_mm256_loadu_si256((const __m256i*)(row + k - 1)), 63));
+        __m256i e  = _mm256_or_si256(_mm256_srli_epi64(x, 1),
+                                     _mm256_slli_epi64(_mm256_loadu_si256((const __m256i*)(row + k + 1)), 63));
+        __m256i we = w ^ e;
+        _mm256_storeu_si256((__m256i*)(ones + k), we ^ x);
+        _mm256_storeu_si256((__m256i*)(twos + k), (w & e) | (x & we));
+    }
+    for (; k < words; k++) rowSumWord(row, k, words, ones, twos);
+}
+
+template <uint32_t Rule = LifeRule::conway().mask()>
+__attribute__((target("avx2"))) inline void stepSummedRowsAVX2(const uint64_t* cur, uint64_t* next, int rows,
+                                                               int words, uint64_t* sums, uint32_t ruleMask = Rule) {
+    uint64_t* ones[3] = {sums, sums + 2 * words, sums + 4 * words};
+    uint64_t* twos[3] = {sums + words, sums + 3 * words, sums + 5 * words};
+
+    rowSumsAVX2(cur, ones[0], twos[0], words);
+    rowSumsAVX2(cur + words, ones[1], twos[1], words);
+
+    for (int r = 1; r <= rows; r++) {
+        rowSumsAVX2(cur + (size_t)(r + 1) * words, ones[2], twos[2], words);
+
+        const uint64_t *mid = cur + (size_t)r * words, *o0 = ones[0], *o1 = ones[1], *o2 = ones[2];
+        const uint64_t *t0 = twos[0], *t1 = twos[1], *t2 = twos[2];
+        uint64_t* out = next + (size_t)r * words;
+        int k         = 0;
+        for (; k + 4 <= words; k += 4) {
+            __m256i a1 = _mm256_loadu_si256((const __m256i*)(o0 + k));
+            __m256i b1 = _mm256_loadu_si256((const __m256i*)(o1 + k));
+            __m256i c1 = _mm256_loadu_si256((const __m256i*)(o2 + k));
+            __m256i a2 = _mm256_loadu_si256((const __m256i*)(t0 + k));
+            __m256i b2 = _mm256_loadu_si256((const __m256i*)(t1 + k));
+            __m256i c2 = _mm256_loadu_si256((const __m256i*)(t2 + k));
+            __m256i me = _mm256_loadu_si256((const __m256i*)(mid + k));
+            __m256i result;
+            summedWord<Rule>(result, a1, b1, c1, a2, b2, c2, me, ruleMask);
+            _mm256_storeu_si256((__m256i*)(out + k), result);
+        }
+        for (; k < words; k++)
+            summedWord<Rule>(out[k], o0[k], o1[k], o2[k], t0[k], t1[k], t2[k], mid[k], ruleMask);
+
+        std::swap(ones[0], ones[1]);
+        std::swap(ones[1], ones[2]);
+        std::swap(twos[0], twos[1]);
+        std::swap(twos[1], twos[2]);
+    }
+}
+#endif
+
+// --------------------------------------------------------------
+// TemporalBlockEngine:
+// The bit-packed kernel with temporal blocking. A plain engine
+// streams the whole board through memory once per generation;
+// this one copies a tile plus a 'depth'-cell margin into a small
+// scratch buffer (L1/L2 sized), advances it 'depth' generations
+// there, and writes back only the tile, so each sweep over main
+// memory covers 'depth' generations.
+//
+// Inside the scratch the valid area shrinks by one cell per
+// generation on every side (a trapezoid in space-time): generation
+// g is computed on rows g .. H-1-g only, and the garbage that
+// creeps in from the scratch's left / right edge stays inside the
+// 64-bit margin word. Neighboring tiles recompute their shared
+// margins instead of exchanging them, which is the price for
+// touching main memory once per sweep.
+//
+// Margins come from the boundary policy. Toroidal and mirror
+// edges are exact because the extended board evolves like the
+// board itself; dead / alive cells off the board are reset after
+// every generation. Mirror sweeps are capped at the board size.
+//
+// Tiles are TILE_ROWS rows by TILE_WORDS words (64 cells each).
+// With the tile in L1, stepSummedRows() can keep each row's
+// horizontal sums for the next two rows, which is where most of
+// the gain over "bitpacked" comes from on a board that already
+// fits in the last-level cache (see bench/temporal_bench).
+// --------------------------------------------------------------
+class TemporalBlockEngine : public LifeEngine {
+   public:
+    static constexpr int TILE_ROWS  = 128;
+    static constexpr int TILE_WORDS = 16;
+    static constexpr int MAX_DEPTH  = 63;  // garbage must stay inside one margin word
+
+   private:
+    int depth;
+    std::vector<uint64_t> cur, next;  // rows x words, no halo: column c = bit c % 64 of word c / 64
+    std::vector<uint64_t> scratchA, scratchB, sums;
+    int rows = 0, cols = 0, words = 0;
+    bool packed = false;  // does 'cur' match the byte grid?
+
+    using SummedStep = void (*)(const uint64_t*, uint64_t*, int, int, uint64_t*, uint32_t);
+    uint32_t ruleMask;
+    SummedStep stepRows;
+    BitPackedEngine single;  // step(): one generation from a filled byte halo
+
+    long long sweeps = 0, tilesLoaded = 0, generations = 0;
+
+    bool getBit(int r, int c) const {
+        return (cur[(size_t)r * words + (c >> 6)] >> (c & 63)) & 1;
+    }
+
+    void resize(int r, int c) {
+        if (r == rows && c == cols)
+            return;
+        rows  = r;
+        cols  = c;
+        words = (c + 63) / 64;
+        cur.assign((size_t)rows * words, 0);
+        next.assign((size_t)rows * words, 0);
+
+        size_t scratch = (size_t)(TILE_ROWS + 2 * MAX_DEPTH) * (TILE_WORDS + 2);
+        scratchA.assign(scratch, 0);
+        scratchB.assign(scratch, 0);
+        sums.assign(6 * (TILE_WORDS + 2), 0);
+        packed = false;
+    }
+
+    // ----------------------------------------------------------
+    // loadWord(r, first, b): 64 cells of board row 'r' (already
+    // mapped onto the board) starting at column 'first', which may
+    // lie partly or wholly off the board.
+    // ----------------------------------------------------------
+    uint64_t loadWord(int r, int first, Boundary b) const {
+        if (first >= 0 && first + 64 <= cols)
+            return cur[(size_t)r * words + (first >> 6)];
+
+        uint64_t w = 0;
+        for (int i = 0; i < 64; i++) {
+            int c   = first + i;
+            int src = c >= 0 && c < cols ? c : haloSource(c, cols, b);
+            bool on = src < 0 ? b == Boundary::Alive : getBit(r, src);
+            w |= (uint64_t)on << i;
+        }
+        return w;
+    }
+
+    // ----------------------------------------------------------
+    // One tile: rows r0 .. r0+th-1, words w0 .. w0+tw-1, advanced
+    // 'k' generations into 'next'.
+    //
+    // Scratch row i is board row r0-k+i; scratch word j covers
+    // board word w0-1+j, so the tile sits at rows k .. k+th-1,
+    // words 1 .. tw.
+    // ----------------------------------------------------------
+    void advanceTile(int r0, int w0, int th, int tw, int k, Boundary b) {
+        const int height = th + 2 * k, width = tw + 2;
+        const bool constant = isConstantBoundary(b);
+        const uint64_t fill = b == Boundary::Alive ? ~0ULL : 0;
+        uint64_t* src = scratchA.data();
+        uint64_t* dst = scratchB.data();
+
+        for (int i = 0; i < height; i++) {
+            int r          = r0 - k + i;
+            int boardRow   = r >= 0 && r < rows ? r : haloSource(r, rows, b);
+            uint64_t* line = src + (size_t)i * width;
+            for (int j = 0; j < width; j++)
+                line[j] = boardRow < 0 ? fill : loadWord(boardRow, (w0 - 1 + j) * 64, b);
+        }
+
+        // Off-board cells to reset after each generation (constant edges only)
+        const int topOff    = constant ? std::max(0, k - r0) : 0;
+        const int bottomOff = constant ? std::max(0, r0 + th + k - rows) : 0;
+        uint64_t keep[TILE_WORDS + 2];
+        bool sideOff = false;
+        for (int j = 0; j < width; j++) {
+            int first = (w0 - 1 + j) * 64;
+            keep[j]   = first + 64 <= 0 || first >= cols ? 0
+                      : first < 0                      ? ~0ULL << -first
+                      : first + 64 > cols              ? ~0ULL >> (first + 64 - cols)
+                                                       : ~0ULL;
+            sideOff   = sideOff || (constant && keep[j] != ~0ULL);
+        }
+
+        for (int g = 1; g <= k; g++) {
+            // Rows g .. height-1-g, each reading one row either side
+            int count = height - 2 * g;
+            stepRows(src + (size_t)(g - 1) * width, dst + (size_t)(g - 1) * width, count, width, sums.data(),
+                     ruleMask);
+
+            if (constant) {
+                for (int i = g; i < topOff; i++) std::fill(dst + (size_t)i * width, dst + (size_t)(i + 1) * width, fill);
+                for (int i = std::max(g, height - bottomOff); i < height - g; i++)
+                    std::fill(dst + (size_t)i * width, dst + (size_t)(i + 1) * width, fill);
+                if (sideOff)
+                    for (int i = g; i < height - g; i++) {
+                        uint64_t* line = dst + (size_t)i * width;
+                        for (int j = 0; j < width; j++) line[j] = (line[j] & keep[j]) | (fill & ~keep[j]);
+                    }
+            }
+            std::swap(src, dst);
+        }
+
+        for (int i = 0; i < th; i++) {
+            const uint64_t* line = src + (size_t)(k + i) * width;
+            uint64_t* out        = &next[(size_t)(r0 + i) * words + w0];
+            for (int j = 0; j < tw; j++) out[j] = line[1 + j] & keep[1 + j];
+        }
+        tilesLoaded++;
+    }
+
+    // One pass over the board: every tile advances 'k' generations.
+    void sweep(int k, Boundary b) {
+        for (int r0 = 0; r0 < rows; r0 += TILE_ROWS)
+            for (int w0 = 0; w0 < words; w0 += TILE_WORDS)
+                advanceTile(r0, w0, std::min(TILE_ROWS, rows - r0), std::min(TILE_WORDS, words - w0), k, b);
+        cur.swap(next);
+        sweeps++;
+        generations += k;
+    }
+
+   public:
+    // Up to 'blockDepth' generations per trip through memory (1..63).
+    explicit TemporalBlockEngine(const LifeRule& rule = LifeRule::conway(), int blockDepth = 16)
+        : ruleMask(rule.mask()), stepRows(dispatchRule(rule.mask(), [](auto m) -> SummedStep {
+#ifdef LIFE_X86_SIMD
+              if (detectSimdLevel() == SimdLevel::AVX2)
+                  return stepSummedRowsAVX2<decltype(m)::value>;
+#endif
+              return stepSummedRows<decltype(m)::value>;
+          })),
+          single(rule) {
+        setDepth(blockDepth);
+    }
+
+    const char* name() const override {
+        return "blocked";
+    }
+
+    // Throws std::invalid_argument outside 1..MAX_DEPTH.
+    void setDepth(int blockDepth) {
+        if (blockDepth < 1 || blockDepth > MAX_DEPTH)
+            throw std::invalid_argument("Block depth must be 1.." + std::to_string(MAX_DEPTH) + ": " +
+                                        std::to_string(blockDepth));
+        depth = blockDepth;
+    }
+    int getDepth() const {
+        return depth;
+    }
+
+    void pack(const GridView& src) {
+        resize(src.rowCount(), src.colCount());
+        for (int r = 0; r < rows; r++) {
+            const uint8_t* in = src[r].begin();
+            uint64_t* out     = &cur[(size_t)r * words];
+
+            for (int k = 0; k < words; k++) out[k] = 0;
+            for (int c = 0; c < cols; c++) out[c >> 6] |= (uint64_t)(in[c] & 1) << (c & 63);
+        }
+        packed = true;
+    }
+
+    void unpack(uint8_t* dst, int stride) const {
+        for (int r = 0; r < rows; r++) unpackBits(&cur[(size_t)r * words], 0, dst + (ptrdiff_t)r * stride, cols);
+    }
+
+    // Advance the packed board in sweeps of up to 'depth' generations.
+    void advance(int gens, Boundary b) {
+        int most = b == Boundary::Mirror ? std::min({depth, rows, cols}) : depth;
+        while (gens > 0) {
+            int k = std::min(gens, most);
+            sweep(k, b);
+            gens -= k;
+        }
+    }
+
+    void step(const GridView& src, uint8_t* dst) override {
+        single.step(src, dst);
+        packed = false;
+    }
+
+    void run(CellBuffer& grid, CellBuffer&, const GridLayout& layout, int gens) override {
+        GridView view(grid.data() + layout.origin(), layout.rows, layout.cols, layout.stride);
+
+        if (!packed || layout.rows != rows || layout.cols != cols)
+            pack(view);
+
+        advance(gens, layout.boundary);
+        unpack(grid.data() + layout.origin(), layout.stride);
+    }
+
+    void invalidate() override {
+        LifeEngine::invalidate();
+        packed = false;
+    }
+
+    bool needsScratch() const override {  // steps its own packed boards
+        return false;
+    }
+
+    void printStats(std::ostream& out) const override {
+        out << "blocked: depth " << depth << ", " << generations << " generations in " << sweeps << " sweeps, "
+            << tilesLoaded << " tile loads (" << TILE_ROWS << " x " << TILE_WORDS * 64 << " cells)\n";
+    }
+};
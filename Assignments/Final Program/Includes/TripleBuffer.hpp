@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// --------------------------------------------------------------
+// TripleBuffer<T>:
+// Hands the newest value from one writer thread to one reader
+// thread without locks and without either side ever waiting.
+//
+// There are three slots. The writer owns 'back', the reader owns
+// 'front', and the third ('middle') is the handoff. publish()
+// swaps back and middle in one atomic exchange and marks middle
+// fresh; update() swaps middle and front if a fresh value is
+// there. The writer can publish faster than the reader reads (old
+// values are simply overwritten), and the reader can read the
+// same value many times while nothing new arrives.
+//
+//     writer:  fill writeSlot(); publish();
+//     reader:  update(); use readSlot();
+// --------------------------------------------------------------
+template <typename T>
+class TripleBuffer {
+   private:
+    static constexpr uint8_t FRESH = 4;  // bit 2: middle not yet taken; bits 0-1: slot index
+
+    T slots[3];
+    std::atomic<uint8_t> middle{1};
+    uint8_t back  = 0;  // writer's slot
+    uint8_t front = 2;  // reader's slot
+
+   public:
+    // All three slots start as copies of 'initial' (e.g. to size
+    // them once, so publishing never allocates).
+    explicit TripleBuffer(const T& initial = T()) : slots{initial, initial, initial} {
+    }
+
+    TripleBuffer(const TripleBuffer&)            = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Writer side
+    T& writeSlot() {
+        return slots[back];
+    }
+    void publish() {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & 3;
+    }
+
+    // Reader side: true if a newer value was taken
+    bool update() {
+        if (!(middle.load(std::memory_order_acquire) & FRESH))
+            return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & 3;
+        return true;
+    }
+    const T& readSlot() const {
+        return slots[front];
+    }
+};
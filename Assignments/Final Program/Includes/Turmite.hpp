@@ -0,0 +1,785 @@
+#pragma once
+
+#include "UnboundedAutomaton.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// --------------------------------------------------------------
+// TurmiteRule:
+// A turmite is an ant with an internal state on a grid of colored
+// cells. Each step it reads the color under it, and the entry for
+// (state, color) says which color to write, how to turn and which
+// state to take next; then it moves one cell forward.
+//
+// Two notations are accepted:
+//   - Langton-style ants (one state): one letter per color, the
+//     turn on that color, e.g. "RL" (Langton's ant), "LLRR",
+//     "RRLLLRLLLRRR". L = left, R = right, N = no turn,
+//     U = U-turn; a cell of color c becomes color c + 1 (wrapping).
+//   - Ed Pegg / Golly turmite tables, one list per state of one
+//     {write, turn, next state} triple per color, turns being
+//     1 = none, 2 = right, 4 = U-turn, 8 = left, e.g.
+//         {{{1,2,0},{0,8,0}}}                    (Langton's ant)
+//         {{{1,8,1},{1,8,1}},{{1,2,1},{0,1,0}}}  (Fibonacci spiral)
+//
+// Up to 16 colors and 16 states.
+// --------------------------------------------------------------
+struct TurmiteRule {
+    static constexpr int MAX_COLORS = 16, MAX_STATES = 16;
+
+    // Turns are added to the direction (0 north, 1 east, 2 south, 3 west)
+    enum Turn : uint8_t { NoTurn = 0, Right = 1, UTurn = 2, Left = 3 };
+
+    struct Action {
+        uint8_t write, turn, next;
+    };
+
+    int colors = 2, states = 1;
+    std::vector<Action> table;  // [state * colors + color]
+
+    const Action& action(int state, int color) const {
+        return table[(size_t)state * colors + color];
+    }
+
+    static TurmiteRule langton() {
+        return ant("RL");
+    }
+
+    // One-state ant from a string of turns (throws std::invalid_argument).
+    static TurmiteRule ant(const std::string& turns) {
+        TurmiteRule rule;
+        rule.colors = (int)turns.size();
+        for (int c = 0; c < rule.colors; c++) {
+            int turn = std::string("NRUL").find((char)std::toupper((unsigned char)turns[c]));
+            if (turn < 0)
+                throw std::invalid_argument("Ant turns are L, R, N or U: " + turns);
+            rule.table.push_back({(uint8_t)((c + 1) % rule.colors), (uint8_t)turn, 0});
+        }
+        rule.validate();
+        return rule;
+    }
+
+    // Throws std::invalid_argument if the table is inconsistent.
+    void validate() const {
+        if (colors < 2 || colors > MAX_COLORS || states < 1 || states > MAX_STATES)
+            throw std::invalid_argument("Turmites need 2..16 colors and 1..16 states");
+        if (table.size() != (size_t)colors * states)
+            throw std::invalid_argument("Turmite table needs one entry per state and color");
+        for (const Action& a : table)
+            if (a.write >= colors || a.turn > 3 || a.next >= states)
+                throw std::invalid_argument("Turmite table entry out of range");
+    }
+
+    bool isAnt() const {
+        if (states != 1)
+            return false;
+        for (int c = 0; c < colors; c++)
+            if (action(0, c).write != (c + 1) % colors)
+                return false;
+        return true;
+    }
+
+    // Ant letters when possible, otherwise the turmite table.
+    std::string toString() const {
+        if (isAnt()) {
+            std::string turns;
+            for (int c = 0; c < colors; c++) turns += "NRUL"[action(0, c).turn];
+            return turns;
+        }
+
+        static const int code[4] = {1, 2, 4, 8};
+        std::string out = "{";
+        for (int s = 0; s < states; s++) {
+            out += s ? ",{" : "{";
+            for (int c = 0; c < colors; c++) {
+                const Action& a = action(s, c);
+                out += (c ? ",{" : "{") + std::to_string(a.write) + "," + std::to_string(code[a.turn]) + "," +
+                       std::to_string(a.next) + "}";
+            }
+            out += "}";
+        }
+        return out + "}";
+    }
+
+    // ----------------------------------------------------------
+    // parse(text):
+    // Ant letters ("RL"), a turmite table ("{{{1,2,0},{0,8,0}}}")
+    // or the name langton. Throws std::invalid_argument otherwise.
+    // ----------------------------------------------------------
+    static TurmiteRule parse(const std::string& text) {
+        std::string t;
+        for (char ch : text)
+            if (!std::isspace((unsigned char)ch))
+                t += (char)std::tolower((unsigned char)ch);
+
+        if (t == "langton")
+            return langton();
+        if (t.empty() || t[0] != '{')
+            return ant(t);
+
+        auto fail = [&]() { return std::invalid_argument("Unknown turmite table: " + text); };
+
+        // {states {colors {write, turn, next}}}: collect the triples by depth
+        std::vector<std::vector<std::vector<int>>> groups;
+        int depth = 0;
+        for (size_t i = 0; i < t.size(); i++) {
+            char ch = t[i];
+            if (ch == '{') {
+                depth++;
+                if (depth == 2)
+                    groups.emplace_back();
+                else if (depth == 3)
+                    groups.back().emplace_back();
+                else if (depth != 1)
+                    throw fail();
+            } else if (ch == '}') {
+                if (depth == 3 && groups.back().back().size() != 3)
+                    throw fail();
+                if (--depth < 0)
+                    throw fail();
+            } else if (std::isdigit((unsigned char)ch)) {
+                if (depth != 3)
+                    throw fail();
+                size_t end = t.find_first_not_of("0123456789", i);
+                std::string digits = t.substr(i, end - i);
+                if (digits.size() > 3 || groups.back().back().size() == 3)
+                    throw fail();
+                groups.back().back().push_back(std::stoi(digits));
+                i = end - 1;
+            } else if (ch != ',') {
+                throw fail();
+            }
+        }
+        if (depth != 0 || groups.empty())
+            throw fail();
+
+        TurmiteRule rule;
+        rule.states = (int)groups.size();
+        rule.colors = (int)groups[0].size();
+        for (const auto& state : groups) {
+            if ((int)state.size() != rule.colors)
+                throw fail();
+            for (const auto& triple : state) {
+                int turn = triple[1] == 1 ? NoTurn : triple[1] == 2 ? Right : triple[1] == 4 ? UTurn : triple[1] == 8 ? Left : -1;
+                if (turn < 0 || triple[0] > 255 || triple[2] > 255)
+                    throw fail();
+                rule.table.push_back({(uint8_t)triple[0], (uint8_t)turn, (uint8_t)triple[2]});
+            }
+        }
+        rule.validate();
+        return rule;
+    }
+};
+
+// --------------------------------------------------------------
+// Turmites:
+// Langton's ant and other turmites on an unbounded plane with
+// 64-bit coordinates. Any number of ants share one universe; each
+// tick every ant takes one step, in the order they were added, so
+// runs are deterministic whatever the speed-ups below do.
+//
+// Cells are stored as 8x8 tiles in a hash map, each tile four
+// 64-bit planes (bit i of plane p = bit p of cell i's color).
+//
+// Speed-ups (both exact):
+//
+//   Transit memo: an ant inside a tile only sees that tile until
+//     it walks out, so (tile contents, entry cell, direction,
+//     state) fixes everything up to the exit: the new contents,
+//     the exit and the step count. Transits are memoized, and an
+//     ant crosses a tile it has seen before with one lookup.
+//     Several ants are advanced in epochs of S ticks, where S is
+//     less than half the distance between the closest pair, so no
+//     two ants can touch the same cell within an epoch and each can
+//     take its S steps alone.
+//
+//   Highways: a lone ant is probed now and then for a periodic
+//     trajectory (Langton's ant builds its highway with period
+//     104 after ~10,000 steps). When the window of radius 2P
+//     around it repeats after P steps, shifted by the drift D, and
+//     nothing lies ahead, the next k periods are known: the ant
+//     moves k*D and every cell in their path becomes a copy of the
+//     window. That is recorded as a Highway (the window, D and k)
+//     instead of being written out, so a jump of any length costs
+//     about one window and cells are read from it on demand.
+//
+// Tiles take precedence over highways: a tile is filled from them
+// when it is created, and existing tiles in a new highway's path
+// are rewritten from it.
+//
+// The base-class grid is a viewport onto the universe (see
+// UnboundedAutomaton); ants are drawn in it as state colors()
+// (stateCount() = colors + 1).
+// --------------------------------------------------------------
+class Turmites : public UnboundedAutomaton {
+   public:
+    struct Ant {
+        int64_t row, col;
+        uint8_t dir;    // 0 north, 1 east, 2 south, 3 west
+        uint8_t state;
+    };
+
+   private:
+    static constexpr int TILE = 8, PLANES = 4;
+    static constexpr uint32_t TRANSIT_LIMIT = 4096;    // steps per memoized transit
+    static constexpr size_t MAX_TRANSITS    = 1 << 18; // memo is flushed past this
+    static constexpr uint64_t MEMO_MIN      = 32;      // shorter runs step directly
+    static constexpr int MAX_PERIOD         = 256;     // longest highway period probed
+    static constexpr uint64_t PROBE_FIRST = 1 << 13, PROBE_MAX = 1 << 22;
+
+    struct Tile {
+        uint64_t planes[PLANES] = {};
+        bool operator==(const Tile& other) const {
+            return std::memcmp(planes, other.planes, sizeof planes) == 0;
+        }
+    };
+
+    struct TileKey {
+        int64_t row, col;  // tile coordinates (cell coordinate / 8)
+        bool operator==(const TileKey& other) const {
+            return row == other.row && col == other.col;
+        }
+    };
+
+    struct TileKeyHash {
+        size_t operator()(const TileKey& k) const {
+            uint64_t h = (uint64_t)k.row * 0x9E3779B97F4A7C15ULL ^ (uint64_t)k.col;
+            h *= 0xBF58476D1CE4E5B9ULL;
+            return (size_t)(h ^ (h >> 31));
+        }
+    };
+
+    // A transit: tile contents and where the ant enters -> what it leaves
+    struct TransitKey {
+        Tile tile;
+        uint16_t entry;  // row | col << 3 | dir << 6 | state << 8
+        bool operator==(const TransitKey& other) const {
+            return entry == other.entry && tile == other.tile;
+        }
+    };
+
+    struct TransitKeyHash {
+        size_t operator()(const TransitKey& k) const {
+            uint64_t h = k.entry;
+            for (uint64_t p : k.tile.planes) h = (h ^ p) * 0x9E3779B97F4A7C15ULL;
+            return (size_t)(h ^ (h >> 29));
+        }
+    };
+
+    struct Transit {
+        Tile after;
+        int8_t row, col;  // exit cell relative to the tile (-1..8)
+        uint8_t dir, state;
+        uint32_t steps;
+    };
+
+    // ----------------------------------------------------------
+    // Highway: the window of 'radius' cells around (row, col),
+    // repeated at (row, col) + j * (dRow, dCol) for j = 0..repeats.
+    // A cell covered by several copies takes the value of the last
+    // one (the largest j), which is the value it froze at.
+    // ----------------------------------------------------------
+    struct Highway {
+        int64_t row, col;
+        int64_t dRow, dCol;
+        int period, radius;
+        uint64_t repeats;
+        std::vector<uint8_t> window;  // (2 radius + 1)^2 colors
+    };
+
+    TurmiteRule rule = TurmiteRule::langton();
+    std::vector<Ant> ants;
+    std::unordered_map<TileKey, Tile, TileKeyHash> tiles;
+    std::unordered_map<TransitKey, Transit, TransitKeyHash> transits;
+    std::vector<Highway> highways;
+
+    uint64_t tick = 0;
+    bool memoize = true, fastForward = true;
+    uint64_t probeGap = PROBE_FIRST, sinceProbe = 0;
+    uint64_t transitHits = 0, transitMisses = 0, highwaySteps = 0;
+
+    static int64_t tileOf(int64_t v) {
+        return v >> 3;
+    }
+    static int cellOf(int64_t v) {
+        return (int)(v & (TILE - 1));
+    }
+
+    static int colorAt(const Tile& t, int i) {
+        int color = 0;
+        for (int p = 0; p < PLANES; p++) color |= (int)((t.planes[p] >> i) & 1) << p;
+        return color;
+    }
+    static void setColor(Tile& t, int i, int color) {
+        uint64_t bit = 1ULL << i;
+        for (int p = 0; p < PLANES; p++) t.planes[p] = (color >> p) & 1 ? t.planes[p] | bit : t.planes[p] & ~bit;
+    }
+    static bool isEmpty(const Tile& t) {
+        return !(t.planes[0] | t.planes[1] | t.planes[2] | t.planes[3]);
+    }
+
+    // Floor / ceiling division for any signs.
+    static int64_t floorDiv(int64_t a, int64_t b) {
+        int64_t q = a / b;
+        return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+    }
+    static int64_t ceilDiv(int64_t a, int64_t b) {
+        return -floorDiv(-a, b);
+    }
+
+    // ----------------------------------------------------------
+    // stepsInto: the j for which the window of 'radius' around
+    // centre + j * d overlaps [lo, hi] on one axis, intersected
+    // with [first, last]. False if there are none.
+    // ----------------------------------------------------------
+    static bool stepsInto(int64_t lo, int64_t hi, int64_t centre, int64_t d, int64_t radius, int64_t& first,
+                          int64_t& last) {
+        int64_t from = lo - centre - radius, to = hi - centre + radius;  // j * d in [from, to]
+        if (d == 0)
+            return from <= 0 && to >= 0 && first <= last;
+        int64_t a = d > 0 ? ceilDiv(from, d) : ceilDiv(-to, -d);
+        int64_t b = d > 0 ? floorDiv(to, d) : floorDiv(-from, -d);
+        first = std::max(first, a);
+        last  = std::min(last, b);
+        return first <= last;
+    }
+
+    // Copies of highway h over the box [r0, r1] x [c0, c1], limited to [first, last].
+    static bool copiesOver(const Highway& h, int64_t r0, int64_t r1, int64_t c0, int64_t c1, int64_t& first,
+                           int64_t& last) {
+        return stepsInto(r0, r1, h.row, h.dRow, h.radius, first, last) &&
+               stepsInto(c0, c1, h.col, h.dCol, h.radius, first, last);
+    }
+
+    // Color of a cell not held by any tile.
+    int highwayColor(int64_t row, int64_t col) const {
+        for (auto h = highways.rbegin(); h != highways.rend(); ++h) {
+            int64_t first = 0, last = (int64_t)h->repeats;
+            if (!copiesOver(*h, row, row, col, col, first, last))
+                continue;
+            int side = 2 * h->radius + 1;
+            int64_t r = row - (h->row + last * h->dRow) + h->radius;
+            int64_t c = col - (h->col + last * h->dCol) + h->radius;
+            return h->window[(size_t)r * side + c];
+        }
+        return 0;
+    }
+
+    // The tile at tile coordinates (tr, tc), created (from the highways) if needed.
+    Tile& tileAt(int64_t tr, int64_t tc) {
+        auto added = tiles.try_emplace({tr, tc});
+        Tile& tile = added.first->second;
+        if (added.second && !highways.empty())
+            for (int i = 0; i < TILE * TILE; i++)
+                setColor(tile, i, highwayColor(tr * TILE + i / TILE, tc * TILE + i % TILE));
+        return tile;
+    }
+
+    // ----------------------------------------------------------
+    // runTile: step an ant at tile-relative (r, c) until it leaves
+    // the tile or has taken 'limit' steps; returns the steps taken.
+    // ----------------------------------------------------------
+    uint64_t runTile(Tile& tile, int& r, int& c, uint8_t& dir, uint8_t& state, uint64_t limit) const {
+        static const int dr[4] = {-1, 0, 1, 0}, dc[4] = {0, 1, 0, -1};
+        uint64_t n = 0;
+        while (n < limit) {
+            int i                         = r * TILE + c;
+            const TurmiteRule::Action& a = rule.action(state, colorAt(tile, i));
+            setColor(tile, i, a.write);
+            dir   = (dir + a.turn) & 3;
+            state = a.next;
+            r += dr[dir];
+            c += dc[dir];
+            n++;
+            if ((unsigned)r >= TILE || (unsigned)c >= TILE)
+                break;
+        }
+        return n;
+    }
+
+    // Advance one ant by exactly 'steps' steps.
+    void advanceAnt(Ant& ant, uint64_t steps) {
+        while (steps > 0) {
+            int64_t tr = tileOf(ant.row), tc = tileOf(ant.col);
+            Tile& tile = tileAt(tr, tc);
+            int r = cellOf(ant.row), c = cellOf(ant.col);
+
+            if (memoize && steps >= MEMO_MIN) {
+                TransitKey key{tile, (uint16_t)(r | c << 3 | ant.dir << 6 | ant.state << 8)};
+                auto found = transits.find(key);
+                if (found == transits.end()) {
+                    transitMisses++;
+                    if (transits.size() >= MAX_TRANSITS)
+                        transits.clear();
+                    Transit t{tile, 0, 0, ant.dir, ant.state, 0};
+                    int er = r, ec = c;
+                    t.steps = (uint32_t)runTile(t.after, er, ec, t.dir, t.state, TRANSIT_LIMIT);
+                    t.row   = (int8_t)er;
+                    t.col   = (int8_t)ec;
+                    found   = transits.emplace(key, t).first;
+                } else {
+                    transitHits++;
+                }
+
+                const Transit& t = found->second;
+                if (t.steps <= steps) {
+                    tile      = t.after;
+                    ant.row   = tr * TILE + t.row;
+                    ant.col   = tc * TILE + t.col;
+                    ant.dir   = t.dir;
+                    ant.state = t.state;
+                    steps -= t.steps;
+                    continue;
+                }
+            }
+
+            steps -= runTile(tile, r, c, ant.dir, ant.state, steps);
+            ant.row = tr * TILE + r;
+            ant.col = tc * TILE + c;
+        }
+    }
+
+    // Ticks every ant can take alone: under half the closest distance.
+    uint64_t epochLength() const {
+        uint64_t closest = std::numeric_limits<uint64_t>::max();
+        for (size_t a = 0; a < ants.size(); a++)
+            for (size_t b = a + 1; b < ants.size(); b++) {
+                uint64_t dr = ants[a].row > ants[b].row ? (uint64_t)ants[a].row - ants[b].row : (uint64_t)ants[b].row - ants[a].row;
+                uint64_t dc = ants[a].col > ants[b].col ? (uint64_t)ants[a].col - ants[b].col : (uint64_t)ants[b].col - ants[a].col;
+                closest     = std::min(closest, std::max(dr, dc));
+            }
+        return closest < 3 ? 1 : (closest - 1) / 2;
+    }
+
+    // Colors of the (2 radius + 1)^2 window around (row, col).
+    void readWindow(int64_t row, int64_t col, int radius, std::vector<uint8_t>& out) const {
+        int side = 2 * radius + 1;
+        out.assign((size_t)side * side, 0);
+        drawColors(row - radius, col - radius, side, side, out.data(), side);
+    }
+
+    // ----------------------------------------------------------
+    // clearPeriods: how many of the periods 1..limit the window
+    // (radius W around 'centre', drifting 'd' per period) can take
+    // before it reaches a live cell that is not in it now, or the
+    // path of another highway ('skip' is the one being extended).
+    // ----------------------------------------------------------
+    uint64_t clearPeriods(int64_t row, int64_t col, int64_t dRow, int64_t dCol, int W, uint64_t limit,
+                          const Highway* skip) const {
+        int64_t reach = (int64_t)limit;
+        auto inWindow = [&](int64_t r, int64_t c) { return r >= row - W && r <= row + W && c >= col - W && c <= col + W; };
+        auto hit = [&](int64_t r0, int64_t r1, int64_t c0, int64_t c1) {
+            int64_t first = 1, last = reach;
+            if (stepsInto(r0, r1, row, dRow, W, first, last) && stepsInto(c0, c1, col, dCol, W, first, last))
+                reach = first - 1;
+        };
+
+        for (const auto& entry : tiles) {
+            if (isEmpty(entry.second))
+                continue;
+            int64_t r0 = entry.first.row * TILE, c0 = entry.first.col * TILE;
+            bool overlaps = r0 + TILE - 1 >= row - W && r0 <= row + W && c0 + TILE - 1 >= col - W && c0 <= col + W;
+            if (!overlaps) {
+                hit(r0, r0 + TILE - 1, c0, c0 + TILE - 1);
+                continue;
+            }
+            // Partly inside the window: only live cells outside it count
+            for (int i = 0; i < TILE * TILE; i++)
+                if (colorAt(entry.second, i) && !inWindow(r0 + i / TILE, c0 + i % TILE))
+                    hit(r0 + i / TILE, r0 + i / TILE, c0 + i % TILE, c0 + i % TILE);
+        }
+
+        // Other highways: stop short of any copy of their window
+        for (const Highway& h : highways) {
+            if (&h == skip)
+                continue;
+            for (uint64_t j = 0; j <= h.repeats && reach > 0; j++) {
+                int64_t r = h.row + (int64_t)j * h.dRow, c = h.col + (int64_t)j * h.dCol;
+                hit(r - h.radius, r + h.radius, c - h.radius, c + h.radius);
+            }
+        }
+        return (uint64_t)std::max<int64_t>(0, reach);
+    }
+
+    // ----------------------------------------------------------
+    // probeHighway: look for a highway within the next 'budget'
+    // ticks of the lone ant and jump along it. Returns the ticks
+    // used (stepping while probing included).
+    // ----------------------------------------------------------
+    uint64_t probeHighway(uint64_t budget) {
+        const int H = 3 * MAX_PERIOD;
+        Ant& ant    = ants[0];
+
+        // 1. record a stretch of trajectory and find its period
+        std::vector<Ant> path(H + 1);
+        path[0] = ant;
+        for (int i = 1; i <= H; i++) {
+            advanceAnt(ant, 1);
+            path[i] = ant;
+        }
+        uint64_t used = H;
+
+        int P = 0;
+        for (int p = 1; p <= MAX_PERIOD && !P; p++) {
+            int64_t dRow = path[H].row - path[H - p].row, dCol = path[H].col - path[H - p].col;
+            if (dRow == 0 && dCol == 0)
+                continue;
+            bool periodic = true;
+            for (int i = H; i > H - 2 * p && periodic; i--)
+                periodic = path[i].row - path[i - p].row == dRow && path[i].col - path[i - p].col == dCol &&
+                           path[i].dir == path[i - p].dir && path[i].state == path[i - p].state;
+            if (periodic)
+                P = p;
+        }
+        if (!P || budget < used + 2 * (uint64_t)P)
+            return used;
+
+        // 2. confirm: the window of radius 2P repeats one period later, shifted
+        const int W  = 2 * P;
+        int64_t dRow = path[H].row - path[H - P].row, dCol = path[H].col - path[H - P].col;
+        std::vector<uint8_t> before, after;
+        readWindow(ant.row, ant.col, W, before);
+        Ant start = ant;
+        advanceAnt(ant, P);
+        used += P;
+        readWindow(ant.row, ant.col, W, after);
+        if (ant.row != start.row + dRow || ant.col != start.col + dCol || ant.dir != start.dir ||
+            ant.state != start.state || before != after)
+            return used;
+
+        // 3. continue the last highway, or start a new one
+        Highway* extend = nullptr;
+        uint64_t offset = 0;
+        if (!highways.empty()) {
+            Highway& last = highways.back();
+            int64_t m     = dRow ? (ant.row - last.row) / dRow : (ant.col - last.col) / dCol;
+            if (last.dRow == dRow && last.dCol == dCol && last.radius == W && m >= 0 &&
+                ant.row == last.row + m * dRow && ant.col == last.col + m * dCol && last.window == after) {
+                extend = &last;
+                offset = (uint64_t)m;
+            }
+        }
+
+        uint64_t k = clearPeriods(ant.row, ant.col, dRow, dCol, W, (budget - used) / P, extend);
+        if (k == 0)
+            return used;
+
+        if (extend)
+            extend->repeats = offset + k;
+        else
+            highways.push_back({ant.row, ant.col, dRow, dCol, P, W, k, after});
+
+        // 4. tiles in the path now read from the highway
+        const Highway& h = extend ? *extend : highways.back();
+        for (auto& entry : tiles) {
+            int64_t r0 = entry.first.row * TILE, c0 = entry.first.col * TILE;
+            int64_t first = 0, last = (int64_t)k;
+            if (!stepsInto(r0, r0 + TILE - 1, ant.row, dRow, W, first, last) ||
+                !stepsInto(c0, c0 + TILE - 1, ant.col, dCol, W, first, last))
+                continue;
+            for (int i = 0; i < TILE * TILE; i++) {
+                int64_t r = r0 + i / TILE, c = c0 + i % TILE;
+                int64_t from = 0, to = (int64_t)h.repeats;
+                if (copiesOver(h, r, r, c, c, from, to))
+                    setColor(entry.second, i, h.window[(size_t)(r - h.row - to * h.dRow + W) * (2 * W + 1) +
+                                                       (size_t)(c - h.col - to * h.dCol + W)]);
+            }
+        }
+
+        ant.row += (int64_t)k * dRow;
+        ant.col += (int64_t)k * dCol;
+        highwaySteps += k * P;
+        return used + k * P;
+    }
+
+    void advanceLoneAnt(uint64_t ticks) {
+        while (ticks > 0) {
+            bool probeDue = fastForward && sinceProbe >= probeGap;
+            if (probeDue && ticks > 4 * (uint64_t)MAX_PERIOD) {
+                uint64_t jumped = highwaySteps;
+                ticks -= probeHighway(ticks);
+                sinceProbe = 0;
+                probeGap   = highwaySteps != jumped ? PROBE_FIRST : std::min(probeGap * 2, PROBE_MAX);
+                continue;
+            }
+            uint64_t n = fastForward && !probeDue ? std::min(ticks, probeGap - sinceProbe) : ticks;
+            advanceAnt(ants[0], n);
+            ticks -= n;
+            sinceProbe += n;
+        }
+    }
+
+    // Colors only (tiles, then highways), into a zeroed buffer.
+    void drawColors(int64_t top, int64_t left, int rowCount, int colCount, uint8_t* out, int outStride) const {
+        int64_t firstRow = tileOf(top), lastRow = tileOf(top + rowCount - 1);
+        int64_t firstCol = tileOf(left), lastCol = tileOf(left + colCount - 1);
+
+        for (int64_t tr = firstRow; tr <= lastRow; tr++)
+            for (int64_t tc = firstCol; tc <= lastCol; tc++) {
+                int64_t r0 = std::max(top, tr * TILE), r1 = std::min(top + rowCount, (tr + 1) * TILE);
+                int64_t c0 = std::max(left, tc * TILE), c1 = std::min(left + colCount, (tc + 1) * TILE);
+                auto found = tiles.find({tr, tc});
+
+                if (found != tiles.end()) {
+                    if (isEmpty(found->second))
+                        continue;
+                    for (int64_t r = r0; r < r1; r++)
+                        for (int64_t c = c0; c < c1; c++)
+                            out[(r - top) * outStride + (c - left)] =
+                                (uint8_t)colorAt(found->second, cellOf(r) * TILE + cellOf(c));
+                } else if (!highways.empty()) {
+                    for (int64_t r = r0; r < r1; r++)
+                        for (int64_t c = c0; c < c1; c++) out[(r - top) * outStride + (c - left)] = (uint8_t)highwayColor(r, c);
+                }
+            }
+    }
+
+   protected:
+    void drawRegion(int64_t top, int64_t left, int rowCount, int colCount, uint8_t* out, int outStride) const override {
+        drawColors(top, left, rowCount, colCount, out, outStride);
+        for (const Ant& ant : ants)
+            if (ant.row >= top && ant.row < top + rowCount && ant.col >= left && ant.col < left + colCount)
+                out[(ant.row - top) * outStride + (ant.col - left)] = (uint8_t)rule.colors;
+    }
+
+   public:
+    // 'r' x 'c' viewport; one ant in its middle, facing north.
+    Turmites(int r, int c, const TurmiteRule& turmite = TurmiteRule::langton()) : UnboundedAutomaton(r, c) {
+        setRule(turmite);
+        addAnt(r / 2, c / 2);
+    }
+
+    // ----------------------------------------------------------
+    // setRule: throws std::invalid_argument for a bad table. The
+    // transit memo belongs to the old rule and is flushed; colors
+    // and ant states past the new rule's range wrap around.
+    // ----------------------------------------------------------
+    void setRule(const TurmiteRule& r) {
+        r.validate();
+        importEdits();
+        rule = r;
+        transits.clear();
+
+        for (auto& entry : tiles)
+            for (int i = 0; i < TILE * TILE; i++) {
+                int color = colorAt(entry.second, i);
+                if (color >= rule.colors)
+                    setColor(entry.second, i, color % rule.colors);
+            }
+        for (Highway& h : highways)
+            for (uint8_t& color : h.window) color %= rule.colors;
+        for (Ant& ant : ants) ant.state %= rule.states;
+        exportViewport();
+    }
+    const TurmiteRule& getRule() const {
+        return rule;
+    }
+
+    // Ants act in the order they were added. dir: 0 N, 1 E, 2 S, 3 W.
+    void addAnt(int64_t row, int64_t col, int dir = 0, int state = 0) {
+        importEdits();
+        ants.push_back({row, col, (uint8_t)(dir & 3), (uint8_t)(state % rule.states)});
+        exportViewport();
+    }
+    void clearAnts() {
+        importEdits();
+        ants.clear();
+        exportViewport();
+    }
+    const std::vector<Ant>& getAnts() const {
+        return ants;
+    }
+
+    // Turn the speed-ups off (e.g. to check them against plain stepping).
+    void setMemoize(bool on) {
+        memoize = on;
+    }
+    void setFastForward(bool on) {
+        fastForward = on;
+    }
+
+    // Advance any number of ticks; the viewport is not refreshed.
+    void advance(uint64_t ticks) {
+        importEdits();
+        tick += ticks;
+
+        if (ants.size() == 1) {
+            advanceLoneAnt(ticks);
+            return;
+        }
+        while (ticks > 0 && !ants.empty()) {
+            uint64_t epoch = std::min(ticks, epochLength());
+            for (Ant& ant : ants) advanceAnt(ant, epoch);
+            ticks -= epoch;
+        }
+    }
+
+    void step() override {
+        advance(1);
+        exportViewport();
+    }
+
+    // Several ticks; the viewport is only refreshed at the end.
+    void step(int gens) override {
+        advance((uint64_t)std::max(0, gens));
+        exportViewport();
+    }
+
+    uint8_t getUniverseCell(int64_t row, int64_t col) const override {
+        auto found = tiles.find({tileOf(row), tileOf(col)});
+        return (uint8_t)(found != tiles.end() ? colorAt(found->second, cellOf(row) * TILE + cellOf(col))
+                                              : highwayColor(row, col));
+    }
+
+    // Colors past the rule's range are clamped to the last one.
+    void setUniverseCell(int64_t row, int64_t col, uint8_t state) override {
+        if (state == 0 && highways.empty() && tiles.find({tileOf(row), tileOf(col)}) == tiles.end())
+            return;
+        setColor(tileAt(tileOf(row), tileOf(col)), cellOf(row) * TILE + cellOf(col), std::min<int>(state, rule.colors - 1));
+    }
+
+    uint64_t getTick() const {
+        return tick;
+    }
+    size_t tileCount() const {
+        return tiles.size();
+    }
+    size_t highwayCount() const {
+        return highways.size();
+    }
+    // Ticks skipped along highways so far.
+    uint64_t getHighwaySteps() const {
+        return highwaySteps;
+    }
+
+    int stateCount() const override {
+        return rule.colors + 1;
+    }
+
+    // '@' ant, '#' (two colors) or the color digit, ' ' color 0
+    void display() const override {
+        GridView grid = getGrid();
+
+        for (int r = 0; r < grid.size(); r++) {
+            for (uint8_t cell : grid[r])
+                std::cout << (cell == rule.colors ? '@' : !cell ? ' ' : rule.colors == 2 ? '#' : "0123456789abcdef"[cell]);
+            std::cout << "\n";
+        }
+    }
+
+    void printStats(std::ostream& out) const override {
+        uint64_t lookups = transitHits + transitMisses;
+        out << "turmites: rule " << rule.toString() << ", tick " << tick << ", " << ants.size() << " ant(s), "
+            << tiles.size() << " tiles (" << tiles.size() * sizeof(Tile) / 1024 << " KB), " << transits.size()
+            << " transits memoized (" << (lookups ? 100 * transitHits / lookups : 0) << "% hits), "
+            << highways.size() << " highway(s) covering " << highwaySteps << " ticks\n";
+    }
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CellularAutomaton.hpp"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// --------------------------------------------------------------
+// UnboundedAutomaton:
+// Base class for automata that live on an unbounded plane with
+// 64-bit coordinates (HashLife, SparseLife, ...).
+//
+// The base-class grid is a VIEWPORT onto the universe: after every
+// step the rows x cols window whose top-left is universe cell
+// (viewRow, viewCol) is copied into it, so getGrid() can be handed
+// straight to SdlScreen::render.
+//
+// Edits made through setCell/toggleCell/randomize/clear only touch
+// the viewport bytes; importEdits() copies the cells that differ
+// from the last export back into the universe. Derived classes
+// call it before stepping and exportViewport() after.
+// --------------------------------------------------------------
+class UnboundedAutomaton : public CellularAutomaton {
+   protected:
+    int64_t viewRow = 0, viewCol = 0;
+    std::vector<uint8_t> shown;  // viewport as last exported
+    bool edited = false;         // viewport bytes changed by the user
+
+    void cellsChanged() override {
+        edited = true;
+    }
+
+    // ----------------------------------------------------------
+    // drawRegion: write every non-zero cell inside the region into
+    // 'out' (already zeroed, 'outStride' bytes per row).
+    // ----------------------------------------------------------
+    virtual void drawRegion(int64_t top, int64_t left, int rowCount, int colCount, uint8_t* out,
+                            int outStride) const = 0;
+
+    // Copy cells the user edited in the viewport into the universe.
+    void importEdits() {
+        if (!edited)
+            return;
+        edited = false;
+
+        for (int r = 0; r < rows; r++)
+            for (int c = 0; c < cols; c++)
+                if (at(r, c) != shown[(size_t)r * cols + c])
+                    setUniverseCell(viewRow + r, viewCol + c, at(r, c));
+    }
+
+    // Copy the universe into the viewport.
+    void exportViewport() {
+        extractRegion(viewRow, viewCol, rows, cols, &at(0, 0), stride);
+        for (int r = 0; r < rows; r++) std::memcpy(&shown[(size_t)r * cols], &at(r, 0), cols);
+    }
+
+   public:
+    UnboundedAutomaton(int r, int c) : CellularAutomaton(r, c), shown((size_t)r * c, 0) {
+    }
+
+    // Read / write single cells anywhere in the universe.
+    virtual uint8_t getUniverseCell(int64_t row, int64_t col) const = 0;
+    virtual void setUniverseCell(int64_t row, int64_t col, uint8_t state) = 0;
+
+    // Move the viewport; its top-left corner is universe cell (row, col).
+    void setViewport(int64_t row, int64_t col) {
+        importEdits();
+        viewRow = row;
+        viewCol = col;
+        exportViewport();
+    }
+    int64_t getViewRow() const {
+        return viewRow;
+    }
+    int64_t getViewCol() const {
+        return viewCol;
+    }
+
+    // Copy any universe region into a byte buffer.
+    void extractRegion(int64_t top, int64_t left, int rowCount, int colCount, uint8_t* out, int outStride) {
+        importEdits();
+        for (int r = 0; r < rowCount; r++) std::memset(out + (size_t)r * outStride, 0, colCount);
+
+        drawRegion(top, left, rowCount, colCount, out, outStride);
+    }
+
+    // ASCII visualization of the viewport
+    void display() const override {
+        GridView grid = getGrid();
+
+        for (int r = 0; r < grid.size(); r++) {
+            for (uint8_t cell : grid[r]) std::cout << (cell ? "⬜" : "  ");
+            std::cout << "\n";
+        }
+    }
+};
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "CellularAutomaton.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// --------------------------------------------------------------
+// WireworldPattern:
+// A rectangle of Wireworld cells read from a simple text format,
+// one character per cell:
+//
+//     .  or space   empty
+//     #             conductor (copper)
+//     @             electron head
+//     ~             electron tail
+//
+// Lines starting with '!' are comments. Short lines are padded
+// with empty cells. parse / load throw std::invalid_argument for
+// any other character (or a file that cannot be opened).
+// --------------------------------------------------------------
+struct WireworldPattern {
+    int rows = 0, cols = 0;
+    std::vector<uint8_t> cells;  // rows x cols, Wireworld states
+
+    uint8_t at(int r, int c) const {
+        return cells[(size_t)r * cols + c];
+    }
+
+    static WireworldPattern parse(std::istream& in) {
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (!line.empty() && line[0] == '!')
+                continue;
+            lines.push_back(line);
+        }
+        while (!lines.empty() && lines.back().find_first_not_of(". ") == std::string::npos) lines.pop_back();
+
+        WireworldPattern p;
+        p.rows = (int)lines.size();
+        for (const std::string& l : lines) p.cols = std::max(p.cols, (int)l.size());
+        p.cells.assign((size_t)p.rows * p.cols, 0);
+
+        static const std::string symbols = ".@~#";  // index = state
+        for (int r = 0; r < p.rows; r++)
+            for (int c = 0; c < (int)lines[r].size(); c++) {
+                char ch = lines[r][c] == ' ' ? '.' : lines[r][c];
+                size_t state = symbols.find(ch);
+                if (state == std::string::npos)
+                    throw std::invalid_argument(std::string("Unknown Wireworld cell '") + ch + "' on line " +
+                                                std::to_string(r + 1));
+                p.cells[(size_t)r * p.cols + c] = (uint8_t)state;
+            }
+        return p;
+    }
+
+    static WireworldPattern load(const std::string& path) {
+        std::ifstream file(path);
+        if (!file)
+            throw std::invalid_argument("Cannot open Wireworld file: " + path);
+        return parse(file);
+    }
+
+    std::string toString() const {
+        std::string out;
+        for (int r = 0; r < rows; r++) {
+            for (int c = 0; c < cols; c++) out += ".@~#"[at(r, c)];
+            out += "\n";
+        }
+        return out;
+    }
+};
+
+// --------------------------------------------------------------
+// Wireworld:
+// Brian Silverman's Wireworld. Each tick
+//     head -> tail, tail -> conductor,
+//     conductor -> head if 1 or 2 of its 8 neighbors are heads.
+//
+// Large Wireworld circuits are mostly idle copper, so instead of
+// scanning the grid every tick keeps the flat indices of its
+// heads and tails. Each head adds 1 to the count of every
+// conductor around it; only those conductors are tested, then
+// the three lists rotate (heads become tails, new heads). The cost
+// of a tick follows the number of electrons, not the board size.
+//
+// Cells edited through the base class (setCell, randomize, ...)
+// make the next step rebuild the lists with one full scan.
+// Toroidal and mirror edges connect wires across the border like
+// the halo would; dead and alive edges are both empty space (a
+// border of permanent heads would only short every edge wire).
+// --------------------------------------------------------------
+class Wireworld : public CellularAutomaton {
+   public:
+    enum State : uint8_t { Empty = 0, Head = 1, Tail = 2, Conductor = 3 };
+
+   private:
+    std::vector<int> heads, tails, fresh;  // flat indices into 'cells'
+    std::vector<uint8_t> counts;           // head neighbors per conductor, this tick
+    std::vector<int> touched;              // conductors with a count
+    int offsets[8];
+    size_t copper       = 0;  // heads + tails + conductors (constant between edits)
+    uint64_t generation = 0;
+    bool edited         = true;
+
+    void cellsChanged() override {
+        edited = true;
+    }
+
+    int indexOf(int r, int c) const {
+        return (r + halo) * stride + (c + halo);
+    }
+
+    void rebuildLists() {
+        edited = false;
+        heads.clear();
+        tails.clear();
+        copper = 0;
+        for (int r = 0; r < rows; r++)
+            for (int c = 0; c < cols; c++) {
+                uint8_t s = at(r, c);
+                if (s > Conductor)
+                    at(r, c) = s = Conductor;  // out-of-range edits become copper
+                if (s == Head)
+                    heads.push_back(indexOf(r, c));
+                else if (s == Tail)
+                    tails.push_back(indexOf(r, c));
+                copper += s != Empty;
+            }
+    }
+
+    void bump(int i, int by = 1) {
+        if (counts[i] == 0)
+            touched.push_back(i);
+        counts[i] += by;
+    }
+
+    // Row / column v of a neighbor: itself inside the board, else
+    // through the boundary policy (-1 = empty space).
+    int source(int v, int n) const {
+        return v >= 0 && v < n ? v : haloSource(v, n, boundary);
+    }
+
+    // ----------------------------------------------------------
+    // A head on the border of a toroidal or mirror board: count it
+    // once for every neighbor position of a conductor that maps
+    // onto it, exactly as a filled halo would.
+    // ----------------------------------------------------------
+    void bumpAcrossEdge(int r, int c) {
+        int seen[9], seenCount = 0;
+        for (int dr = -1; dr <= 1; dr++)
+            for (int dc = -1; dc <= 1; dc++) {
+                int xr = source(r + dr, rows), xc = source(c + dc, cols);
+                if (xr < 0 || xc < 0 || cells[indexOf(xr, xc)] != Conductor)
+                    continue;
+                int x = indexOf(xr, xc);
+                if (std::find(seen, seen + seenCount, x) != seen + seenCount)
+                    continue;
+                seen[seenCount++] = x;
+
+                int hits = 0;
+                for (int pr = -1; pr <= 1; pr++)
+                    for (int pc = -1; pc <= 1; pc++)
+                        if ((pr || pc) && source(xr + pr, rows) == r && source(xc + pc, cols) == c)
+                            hits++;
+                if (hits)
+                    bump(x, hits);
+            }
+    }
+
+   public:
+    Wireworld(int r, int c) : CellularAutomaton(r, c), counts(cells.size(), 0) {
+        int k = 0;
+        for (int dr = -1; dr <= 1; dr++)
+            for (int dc = -1; dc <= 1; dc++)
+                if (dr || dc)
+                    offsets[k++] = dr * stride + dc;
+    }
+
+    // Copy a pattern in with its top-left at (top, left); cells
+    // outside the board are dropped.
+    void place(const WireworldPattern& p, int top, int left) {
+        for (int r = 0; r < p.rows; r++)
+            for (int c = 0; c < p.cols; c++)
+                if (inBounds(top + r, left + c))
+                    at(top + r, left + c) = p.at(r, c);
+        cellsChanged();
+    }
+
+    int stateCount() const override {
+        return 4;
+    }
+
+    using CellularAutomaton::step;  // step(gens) loops over step()
+
+    void step() override {
+        if (edited)
+            rebuildLists();
+        const bool wraps = boundary == Boundary::Toroidal || boundary == Boundary::Mirror;
+
+        // 1. every head bumps the conductors around it
+        touched.clear();
+        for (int h : heads) {
+            int r = h / stride - halo, c = h % stride - halo;
+            if (wraps && (r == 0 || c == 0 || r == rows - 1 || c == cols - 1)) {
+                bumpAcrossEdge(r, c);
+                continue;
+            }
+            for (int off : offsets)
+                if (cells[h + off] == Conductor)  // the halo stays empty
+                    bump(h + off);
+        }
+
+        // 2. conductors with 1 or 2 head neighbors fire
+        fresh.clear();
+        for (int i : touched) {
+            if (counts[i] <= 2)
+                fresh.push_back(i);
+            counts[i] = 0;
+        }
+
+        // 3. write the changes and rotate the lists
+        for (int t : tails) cells[t] = Conductor;
+        for (int h : heads) cells[h] = Tail;
+        for (int f : fresh) cells[f] = Head;
+        std::swap(tails, heads);  // tails = old heads
+        std::swap(heads, fresh);  // heads = new heads; old tails are recycled
+        generation++;
+    }
+
+    uint64_t getGeneration() const {
+        return generation;
+    }
+    size_t headCount() const {
+        return heads.size();
+    }
+    size_t tailCount() const {
+        return tails.size();
+    }
+
+    // Same characters as the text format
+    void display() const override {
+        GridView grid = getGrid();
+
+        for (int r = 0; r < grid.size(); r++) {
+            for (uint8_t cell : grid[r]) std::cout << " @~#"[cell & 3];
+            std::cout << "\n";
+        }
+    }
+
+    void printStats(std::ostream& out) const override {
+        out << "wireworld: generation " << generation << ", " << heads.size() << " heads, " << tails.size()
+            << " tails, " << copper << " copper cells of " << (size_t)rows * cols << ", " << touched.size()
+            << " conductors tested last tick\n";
+    }
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "Parallel.hpp"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+// --------------------------------------------------------------
+// WorkStealingScheduler:
+// Runs 'count' independent tasks (e.g. one generation's active
+// tiles) on a persistent ThreadPool, balanced by work stealing.
+//
+// Every worker starts with a contiguous share of the tasks in its
+// own deque (neighboring tiles stay on one thread). It takes work
+// from the back of its own deque; once that is empty it steals
+// from the front of the other workers' deques. When all work sits
+// in one corner of the board, the workers owning that corner end
+// up sharing it with everyone else instead of finishing last.
+//
+// The deques are arrays guarded by one mutex each; a task (a
+// 64x64 tile) takes microseconds, so the locks are not the
+// bottleneck. Their storage only grows, so run() does not
+// allocate in steady state. Tasks never create tasks, so a worker
+// that finds every deque empty is done.
+// --------------------------------------------------------------
+class WorkStealingScheduler {
+   public:
+    struct WorkerStats {
+        long long tasks  = 0;  // tasks run by this worker
+        long long stolen = 0;  // ... of which taken from another deque
+        double busy      = 0;  // seconds inside tasks
+        double idle      = 0;  // seconds in run() outside tasks
+    };
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    struct alignas(64) Deque {  // one per worker, on its own cache line
+        std::mutex lock;
+        std::vector<int> tasks;
+        int head = 0, tail = 0;  // tasks[head, tail) are waiting
+    };
+
+    ThreadPool pool;
+    std::unique_ptr<Deque[]> deques;
+    std::vector<WorkerStats> stats;
+    std::vector<double> roundBusy;  // busy seconds in the current run()
+
+    bool takeOwn(int w, int& task) {
+        Deque& d = deques[w];
+        std::lock_guard<std::mutex> guard(d.lock);
+        if (d.head == d.tail)
+            return false;
+        task = d.tasks[--d.tail];
+        return true;
+    }
+
+    bool steal(int w, int& task) {
+        int n = pool.size();
+        for (int v = 1; v < n; v++) {
+            Deque& d = deques[(w + v) % n];
+            std::lock_guard<std::mutex> guard(d.lock);
+            if (d.head < d.tail) {
+                task = d.tasks[d.head++];
+                stats[w].stolen++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename Task>
+    void work(int w, Task& runTask) {
+        double busy = 0;
+        int task;
+        while (takeOwn(w, task) || steal(w, task)) {
+            Clock::time_point start = Clock::now();
+            runTask(task);
+            busy += std::chrono::duration<double>(Clock::now() - start).count();
+            stats[w].tasks++;
+        }
+        roundBusy[w] = busy;
+    }
+
+   public:
+    explicit WorkStealingScheduler(int threads)
+        : pool(threads), deques(new Deque[pool.size()]), stats(pool.size()), roundBusy(pool.size(), 0.0) {
+    }
+
+    int size() const {
+        return pool.size();
+    }
+
+    // ----------------------------------------------------------
+    // run(count, task): task(i) for every i in [0, count), spread
+    // over the workers. Returns when all of them are done.
+    // ----------------------------------------------------------
+    template <typename Task>
+    void run(int count, Task&& task) {
+        int n = pool.size();
+        for (int w = 0; w < n; w++) {
+            Deque& d  = deques[w];
+            int first = bandStart(count, w, n), last = bandStart(count, w + 1, n);
+            if ((int)d.tasks.size() < last - first)
+                d.tasks.resize(last - first);
+            for (int i = first; i < last; i++) d.tasks[i - first] = i;
+            d.head = 0;
+            d.tail = last - first;
+        }
+
+        Clock::time_point start = Clock::now();
+        pool.run([this, &task](int w) { work(w, task); });
+        double wall = std::chrono::duration<double>(Clock::now() - start).count();
+
+        for (int w = 0; w < n; w++) {
+            stats[w].busy += roundBusy[w];
+            stats[w].idle += std::max(0.0, wall - roundBusy[w]);
+        }
+    }
+
+    const std::vector<WorkerStats>& workerStats() const {
+        return stats;
+    }
+
+    // One line per worker: tasks, stolen, busy and idle time.
+    void printStats(std::ostream& out) const {
+        for (size_t w = 0; w < stats.size(); w++) {
+            const WorkerStats& s = stats[w];
+            double total         = s.busy + s.idle;
+            out << "  worker " << w << ": " << s.tasks << " tasks (" << s.stolen << " stolen), busy " << s.busy
+                << " s, idle " << s.idle << " s (" << (total > 0 ? 100.0 * s.busy / total : 0.0) << "% busy)\n";
+        }
+    }
+};
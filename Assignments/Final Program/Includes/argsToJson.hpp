@@ -17,7 +17,14 @@ json ArgsToJson(int argc, char* argv[]) {
 
         std::string key{arg.substr(0, separator)};
         std::string value{arg.substr(separator + 1)};
-        params[key] = json::parse(value);
+
+        // Values are JSON (numbers, arrays, true/false, ...). Anything that
+        // is not valid JSON is kept as a plain string, e.g. engine=bitpacked.
+        json parsed = json::parse(value, nullptr, false);
+        if (parsed.is_discarded())
+            params[key] = value;
+        else
+            params[key] = parsed;
     }
 
     return params;
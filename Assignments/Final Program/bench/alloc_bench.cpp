@@ -0,0 +1,66 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: alloc_bench.cpp
+ *
+ * Description:
+ *    Proves ConwayLife::step() does no heap
+ *    allocation once warmed up. Counts every
+ *    operator new (see AllocCounter.hpp) during
+ *    steady-state stepping of each engine, on one
+ *    thread and on four row bands.
+ *    Exits with status 1 if any engine allocates.
+ *
+ *    Usage: ./bench/alloc_bench [size=512] [gens=50]
+ * =========================================
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "AllocCounter.hpp"
+#include "ConwayLife.hpp"
+#include "argsToJson.hpp"
+
+int main(int argc, char* argv[]) {
+    int size = 512;
+    int gens = 50;
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("size")) size = args["size"];
+    if (args.contains("gens")) gens = args["gens"];
+
+    std::vector<std::string> engines = {"scalar", "simd", "branchless", "bitpacked", "runningsum", "lookup", "tiles", "frontier", "blocked"};
+    bool allocated                   = false;
+
+    std::printf("%-12s %8s %12s %14s\n", "engine", "threads", "step() x N", "step(N) x 1");
+
+    for (int threads : {1, 4}) {
+        for (const std::string& name : engines) {
+            ConwayLife gol(size, size);
+            gol.setEngine(name);
+            gol.setThreads(threads);
+
+            // Warm up: engines size their scratch buffers (and the thread
+            // pool starts) on first use
+            gol.step();
+            gol.step(2);
+
+            AllocationScope single;
+            for (int g = 0; g < gens; g++) gol.step();
+            size_t singleCount = single.count();
+
+            AllocationScope batch;
+            gol.step(gens);
+            size_t batchCount = batch.count();
+
+            std::printf("%-12s %8d %12zu %14zu\n", name.c_str(), threads, singleCount, batchCount);
+            allocated = allocated || singleCount || batchCount;
+        }
+    }
+
+    std::printf(allocated ? "FAIL: steady-state stepping allocated\n" : "OK: zero allocations\n");
+    return allocated ? 1 : 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: elementary_bench.cpp
+ *
+ * Description:
+ *    Cell-updates per second of the bit-packed
+ *    elementary (1D) automaton for a few Wolfram
+ *    rules on one core, checked against a byte-per-
+ *    cell loop for the first generations.
+ *
+ *    pbm=file.pbm also writes the space-time diagram
+ *    of the first rule (pbmWidth x pbmGens, one
+ *    live cell to start) as a PBM image, headless.
+ *
+ *    Usage: ./bench/elementary_bench [rules=[30,110,90,184]]
+ *               [width=65536] [gens=20000] [boundary=toroidal]
+ *               [pbm=""] [pbmWidth=1024] [pbmGens=512]
+ * =========================================
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Elementary.hpp"
+#include "argsToJson.hpp"
+
+// Byte-per-cell reference for 'gens' generations.
+bool matchesBytes(int rule, int width, int gens, Boundary boundary) {
+    srand(2143);
+    Elementary fast(1, width, rule);
+    fast.setBoundary(boundary);
+    std::vector<uint8_t> cells(width);
+    for (int c = 0; c < width; c++) {
+        cells[c] = rand() & 1;
+        fast.setLineCell(c, cells[c]);
+    }
+
+    auto cell = [&](int i) -> int {
+        if (i >= 0 && i < width)
+            return cells[i];
+        int source = haloSource(i, width, boundary);
+        return source < 0 ? boundary == Boundary::Alive : cells[source];
+    };
+
+    for (int g = 0; g < gens; g++) {
+        std::vector<uint8_t> next(width);
+        for (int c = 0; c < width; c++) next[c] = (rule >> (4 * cell(c - 1) + 2 * cell(c) + cell(c + 1))) & 1;
+        cells = next;
+        fast.advance();
+    }
+
+    for (int c = 0; c < width; c++)
+        if (fast.getLineCell(c) != (bool)cells[c])
+            return false;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> rules = {30, 110, 90, 184};
+    int width              = 65536;
+    int gens               = 20000;
+    Boundary boundary      = Boundary::Toroidal;
+    std::string pbm        = "";
+    int pbmWidth           = 1024;
+    int pbmGens            = 512;
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("rules"))    rules    = args["rules"].get<std::vector<int>>();
+    if (args.contains("width"))    width    = args["width"];
+    if (args.contains("gens"))     gens     = args["gens"];
+    if (args.contains("boundary")) boundary = parseBoundary(args["boundary"]);
+    if (args.contains("pbm"))      pbm      = args["pbm"];
+    if (args.contains("pbmWidth")) pbmWidth = args["pbmWidth"];
+    if (args.contains("pbmGens"))  pbmGens  = args["pbmGens"];
+
+    bool ok = true;
+    std::printf("%-6s %10s %10s %14s %8s\n", "rule", "width", "gens", "cells/sec", "check");
+
+    for (int rule : rules) {
+        bool same = matchesBytes(rule, 1000, 300, boundary);
+        ok        = ok && same;
+
+        srand(2143);
+        Elementary line(1, width, rule);
+        line.setBoundary(boundary);
+        for (int c = 0; c < width; c++) line.setLineCell(c, rand() & 1);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int g = 0; g < gens; g++) line.advance();
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("%-6d %10d %10d %14.3e %8s\n", rule, width, gens, (double)width * gens / sec,
+                    same ? "match" : "MISMATCH");
+    }
+
+    if (!pbm.empty() && !rules.empty()) {
+        std::ofstream out(pbm, std::ios::binary);
+        Elementary diagram(1, pbmWidth, rules[0]);
+        diagram.setBoundary(boundary);
+        diagram.writePBM(out, pbmGens);
+        std::printf("wrote %s (rule %d, %d x %d)\n", pbm.c_str(), rules[0], pbmWidth, pbmGens + 1);
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: engine_bench.cpp
+ *
+ * Description:
+ *    Times every ConwayLife engine on the same
+ *    random board, reports cell-updates per second
+ *    and the speedup over the countNeighbors loop,
+ *    and checks each result matches it exactly.
+ *
+ *    Usage: ./bench/engine_bench [sizes=[1024,4096]] [gens=10]
+ *                                [batch=1] [engines=["sse2","avx2"]]
+ *                                [boundary=dead] [density=0.25]
+ *                                [rules=["B3/S23","B36/S23"]] [threads=1]
+ *
+ *    batch = generations per step(n) call (like gensPerFrame).
+ *    threads = ConwayLife::setThreads for every engine, scalar
+ *              included (only some engines split into bands, so
+ *              the default of 1 compares them all single-threaded).
+ *    rules = Life-like rules to time (each gets its own table);
+ *            avx2 should run any rule about as fast as B3/S23;
+ *            sse2 pays one compare per rule key (up to 9).
+ *
+ *    After each table every engine also runs a small board through
+ *    a sequence of boundary switches, which must match "scalar".
+ * =========================================
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ConwayLife.hpp"
+#include "argsToJson.hpp"
+
+// Runs 'gens' generations on 'gol' in calls of 'batch'; returns seconds.
+double timeEngine(ConwayLife& gol, int gens, int batch) {
+    auto start = std::chrono::steady_clock::now();
+    for (int done = 0; done < gens; done += batch) gol.step(std::min(batch, gens - done));
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+bool sameGrid(const GridView& a, const GridView& b) {
+    for (int r = 0; r < a.rowCount(); r++)
+        for (int c = 0; c < a.colCount(); c++)
+            if (a[r][c] != b[r][c])
+                return false;
+    return true;
+}
+
+// --------------------------------------------------------------
+// switchesMatch(name, rule, batch, threads):
+// Steps a small board under 'name' and under "scalar" through
+// dead -> toroidal -> dead -> alive -> mirror -> alive, a few
+// generations each, and compares them after every phase. Catches
+// halos cached for one policy being reused under another.
+// --------------------------------------------------------------
+bool switchesMatch(const std::string& name, const LifeRule& rule, int batch, int threads) {
+    const Boundary phases[] = {Boundary::Dead,  Boundary::Toroidal, Boundary::Dead,
+                               Boundary::Alive, Boundary::Mirror,   Boundary::Alive};
+    srand(2143);
+    ConwayLife reference(70, 90);
+    srand(2143);
+    ConwayLife gol(70, 90);
+    reference.setEngine("scalar");
+    reference.setRule(rule);
+    reference.setThreads(1);
+    gol.setEngine(name);
+    gol.setRule(rule);
+    gol.setThreads(threads);
+
+    for (Boundary b : phases) {
+        reference.setBoundary(b);
+        gol.setBoundary(b);
+        timeEngine(reference, 6, batch);
+        timeEngine(gol, 6, batch);
+        if (!sameGrid(gol.getGrid(), reference.getGrid()))
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes           = {1024, 4096};
+    std::vector<std::string> engines = {"runningsum", "lookup", "tiles", "frontier", "branchless", "sse2", "avx2", "bitpacked", "blocked"};
+    int gens                         = 10;
+    int batch                        = 1;
+    Boundary boundary                = Boundary::Dead;
+    double density                   = 0.25;
+    std::vector<std::string> rules   = {"B3/S23"};
+    int threads                      = 1;
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("sizes"))   sizes   = args["sizes"].get<std::vector<int>>();
+    if (args.contains("engines")) engines = args["engines"].get<std::vector<std::string>>();
+    if (args.contains("gens"))    gens    = args["gens"];
+    if (args.contains("batch"))   batch   = args["batch"];
+    if (args.contains("boundary")) boundary = parseBoundary(args["boundary"]);
+    if (args.contains("density"))  density  = args["density"];
+    if (args.contains("rules"))    rules    = args["rules"].get<std::vector<std::string>>();
+    if (args.contains("threads"))  threads  = args["threads"];
+
+    for (const std::string& text : rules) {
+        LifeRule rule = LifeRule::parse(text);
+        std::printf("rule %s, %d thread%s\n", rule.toString().c_str(), threads, threads == 1 ? "" : "s");
+        std::printf("%-7s %-12s %14s %9s\n", "board", "engine", "cells/sec", "speedup");
+
+        for (int n : sizes) {
+            double cellsRun = (double)n * n * gens;
+
+            // Reference: the original countNeighbors loop
+            srand(2143);
+            ConwayLife reference(n, n);
+            reference.randomize(density);
+            reference.setEngine("scalar");
+            reference.setRule(rule);
+            reference.setBoundary(boundary);
+            reference.setThreads(threads);
+            double refSec = timeEngine(reference, gens, batch);
+            std::printf("%-7d %-12s %14.3e %8.2fx\n", n, "scalar", cellsRun / refSec, 1.0);
+
+            for (const std::string& name : engines) {
+                srand(2143);
+                ConwayLife gol(n, n);
+                gol.randomize(density);
+                try {
+                    gol.setEngine(name);
+                    gol.setRule(rule);
+                }
+                catch (const std::invalid_argument& e) {
+                    std::printf("%-7d %-12s %s\n", n, name.c_str(), e.what());
+                    continue;
+                }
+                gol.setBoundary(boundary);
+                gol.setThreads(threads);
+                double sec = timeEngine(gol, gens, batch);
+
+                std::printf("%-7d %-12s %14.3e %8.2fx%s\n", n, name.c_str(), cellsRun / sec, refSec / sec,
+                            sameGrid(gol.getGrid(), reference.getGrid()) ? "" : "  MISMATCH");
+                if (gol.getEngine())
+                    gol.getEngine()->printStats(std::cout);
+            }
+        }
+
+        std::printf("boundary switches:");
+        for (const std::string& name : engines) {
+            try {
+                std::printf(" %s %s", name.c_str(), switchesMatch(name, rule, batch, threads) ? "match" : "MISMATCH");
+            }
+            catch (const std::invalid_argument&) {
+                std::printf(" %s n/a", name.c_str());
+            }
+        }
+        std::printf("\n");
+    }
+
+    return 0;
+}
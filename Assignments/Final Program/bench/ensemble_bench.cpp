@@ -0,0 +1,154 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: ensemble_bench.cpp
+ *
+ * Description:
+ *    Thousands of small random soups, run until
+ *    each one settles (repeats with any period) or
+ *    'gens' generations pass: once as a bit-sliced
+ *    LifeEnsemble (64 boards per word) with 1, 2,
+ *    4, ... threads, and the first 'compare' boards
+ *    again as separate ConwayLife instances (one
+ *    thread, engine=...), the way it was done
+ *    before. Every compared board must end with the
+ *    same cells.
+ *
+ *    Prints cell-updates/sec and boards/sec for
+ *    both, then settle generation, period and
+ *    population for the first 'list' boards and a
+ *    summary over all of them (how many settled,
+ *    with which periods, and when).
+ *
+ *    Usage: ./bench/ensemble_bench [boards=4096]
+ *               [size=64] [gens=4000] [density=0.5]
+ *               [seed=1] [threads=[1,2,4]]
+ *               [compare=256] [engine="simd"] [list=8]
+ * =========================================
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ConwayLife.hpp"
+#include "LifeEnsemble.hpp"
+#include "argsToJson.hpp"
+
+// Cell updates the ensemble performed (each board counted by its
+// batch's generations, as separate boards would have to run).
+double cellsRun(const LifeEnsemble& ens, int size) {
+    double gens = 0;
+    for (int board = 0; board < ens.size(); board++) gens += ens.generation(board);
+    return gens * size * size;
+}
+
+int main(int argc, char* argv[]) {
+    int boards             = 4096;
+    int size               = 64;
+    int gens               = 4000;
+    double density         = 0.5;
+    uint64_t seed          = 1;
+    int compare            = 256;
+    int list               = 8;
+    std::string engineName = "simd";
+    std::vector<int> threads;
+
+    for (int t = 1; t < defaultThreadCount(); t *= 2) threads.push_back(t);
+    threads.push_back(defaultThreadCount());
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("boards"))  boards     = args["boards"];
+    if (args.contains("size"))    size       = args["size"];
+    if (args.contains("gens"))    gens       = args["gens"];
+    if (args.contains("density")) density    = args["density"];
+    if (args.contains("seed"))    seed       = args["seed"];
+    if (args.contains("threads")) threads    = args["threads"].get<std::vector<int>>();
+    if (args.contains("compare")) compare    = args["compare"];
+    if (args.contains("engine"))  engineName = args["engine"];
+    if (args.contains("list"))    list       = args["list"];
+    compare = std::min(compare, boards);
+
+    std::printf("%d boards of %dx%d, density %.2f, up to %d generations\n%-10s %8s %14s %12s %8s\n", boards, size,
+                size, density, gens, "mode", "threads", "cells/sec", "boards/sec", "check");
+
+    // Bit-sliced ensemble, once per thread count
+    LifeEnsemble ens(boards, size, size);
+    double ensembleRate = 0;
+    for (int t : threads) {
+        ens.setThreads(t);
+        ens.randomize(seed, density);
+
+        auto start = std::chrono::steady_clock::now();
+        ens.run(gens);
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (t == threads.front())
+            ensembleRate = cellsRun(ens, size) / sec;
+        std::printf("%-10s %8d %14.3e %12.1f %8s\n", "ensemble", t, cellsRun(ens, size) / sec, boards / sec, "");
+    }
+
+    // The first 'compare' boards as separate ConwayLife instances,
+    // each run as many generations as its batch did
+    bool ok         = true;
+    double sepCells = 0, sepSec = 0;
+    for (int board = 0; board < compare; board++) {
+        ConwayLife gol(size, size);
+        gol.setEngine(engineName);
+        gol.setThreads(1);
+        gol.clear();
+
+        // Same soup: board k was drawn from seed + k
+        LifeEnsemble one(1, size, size);
+        one.randomize(seed + board, density);
+        for (int r = 0; r < size; r++)
+            for (int c = 0; c < size; c++) gol.setCell(r, c, one.getCell(0, r, c));
+
+        auto start = std::chrono::steady_clock::now();
+        gol.step(ens.generation(board));
+        sepSec += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        sepCells += (double)ens.generation(board) * size * size;
+
+        for (int r = 0; r < size && ok; r++)
+            for (int c = 0; c < size; c++)
+                if (gol.getCell(r, c) != ens.getCell(board, r, c)) {
+                    ok = false;
+                    break;
+                }
+    }
+    if (compare > 0)
+        std::printf("%-10s %8d %14.3e %12.1f %8s\n%.1fx cell-updates/sec for the ensemble on one thread\n",
+                    engineName.c_str(), 1, sepCells / sepSec, compare / sepSec, ok ? "match" : "MISMATCH",
+                    ensembleRate / (sepCells / sepSec));
+
+    // Per-board results
+    std::printf("\n%-7s %10s %8s %7s %11s %11s\n", "board", "seed", "settled", "period", "settledPop", "population");
+    for (int board = 0; board < std::min(list, boards); board++)
+        std::printf("%-7d %10llu %8d %7d %11lld %11lld\n", board, (unsigned long long)(seed + board),
+                    ens.settledAt(board), ens.settledPeriod(board), ens.settledPopulation(board),
+                    ens.population(board));
+
+    int settled = 0, lastSettle = 0;
+    double genSum = 0, popSum = 0;
+    std::map<int, int> periods;  // period -> boards
+    for (int board = 0; board < boards; board++)
+        if (ens.settledAt(board) >= 0) {
+            settled++;
+            periods[ens.settledPeriod(board)]++;
+            lastSettle = std::max(lastSettle, ens.settledAt(board));
+            genSum += ens.settledAt(board);
+            popSum += ens.settledPopulation(board);
+        }
+    std::printf("%d of %d settled (%d still changing at %d), settle generation mean %.1f / max %d, mean final "
+                "population %.1f\nperiods:",
+                settled, boards, boards - settled, gens, settled ? genSum / settled : 0.0, lastSettle,
+                settled ? popSum / settled : 0.0);
+    for (auto [period, count] : periods) std::printf(" p%d x%d", period, count);
+    std::printf("\n");
+
+    return ok ? 0 : 1;
+}
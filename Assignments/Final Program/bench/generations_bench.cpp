@@ -0,0 +1,91 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: generations_bench.cpp
+ *
+ * Description:
+ *    Times the Generations row kernels (scalar,
+ *    sse2, avx2) on the same random board for each
+ *    rule, reports cell-updates per second and the
+ *    speedup over the scalar kernel, and checks
+ *    each result matches it exactly.
+ *
+ *    Usage: ./bench/generations_bench [sizes=[1024,4096]] [gens=10]
+ *               [rules=["B2/S/C3","B2/S345/C4"]] [density=0.25]
+ * =========================================
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Generations.hpp"
+#include "argsToJson.hpp"
+
+// Runs 'gens' generations; returns seconds.
+double timeKernel(Generations& model, int gens) {
+    auto start = std::chrono::steady_clock::now();
+    model.step(gens);
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+bool sameGrid(const GridView& a, const GridView& b) {
+    for (int r = 0; r < a.rowCount(); r++)
+        for (int c = 0; c < a.colCount(); c++)
+            if (a[r][c] != b[r][c])
+                return false;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes         = {1024, 4096};
+    std::vector<std::string> rules = {"B2/S/C3", "B2/S345/C4"};
+    int gens                       = 10;
+    double density                 = 0.25;
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("sizes"))   sizes   = args["sizes"].get<std::vector<int>>();
+    if (args.contains("rules"))   rules   = args["rules"].get<std::vector<std::string>>();
+    if (args.contains("gens"))    gens    = args["gens"];
+    if (args.contains("density")) density = args["density"];
+
+    for (const std::string& text : rules) {
+        GenerationsRule rule = GenerationsRule::parse(text);
+        std::printf("rule %s\n", rule.toString().c_str());
+        std::printf("%-7s %-8s %14s %9s\n", "board", "kernel", "cells/sec", "speedup");
+
+        for (int n : sizes) {
+            double cellsRun = (double)n * n * gens;
+
+            srand(2143);
+            Generations reference(n, n, rule);
+            reference.randomize(density);
+            reference.setSimdLevel(SimdLevel::Scalar);
+            double refSec = timeKernel(reference, gens);
+            std::printf("%-7d %-8s %14.3e %8.2fx\n", n, "scalar", cellsRun / refSec, 1.0);
+
+            for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2}) {
+                srand(2143);
+                Generations model(n, n, rule);
+                model.randomize(density);
+                try {
+                    model.setSimdLevel(level);
+                }
+                catch (const std::invalid_argument& e) {
+                    std::printf("%-7d %-8s %s\n", n, simdLevelName(level), e.what());
+                    continue;
+                }
+                double sec = timeKernel(model, gens);
+
+                std::printf("%-7d %-8s %14.3e %8.2fx%s\n", n, simdLevelName(level), cellsRun / sec, refSec / sec,
+                            sameGrid(model.getGrid(), reference.getGrid()) ? "" : "  MISMATCH");
+            }
+        }
+    }
+
+    return 0;
+}
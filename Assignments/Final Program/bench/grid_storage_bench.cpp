@@ -0,0 +1,132 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: grid_storage_bench.cpp
+ *
+ * Description:
+ *    Compares the original vector<vector<int>>
+ *    board against the flat uint8_t board used
+ *    by CellularAutomaton. Reports cell-updates
+ *    per second and bytes of storage per cell.
+ *
+ *    Usage: ./bench/grid_storage_bench [gens=5] [sizes=[1024,8192]]
+ *                                      [threads=1]
+ *
+ *    threads = row bands for the flat board (1 keeps the
+ *              comparison with the one-threaded legacy board fair).
+ * =========================================
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "ConwayLife.hpp"
+#include "argsToJson.hpp"
+
+// --------------------------------------------------------------
+// LegacyLife:
+// The board exactly as it was stored before the flat grid:
+// one heap-allocated vector<int> per row, copied every step.
+// --------------------------------------------------------------
+struct LegacyLife {
+    int rows, cols;
+    std::vector<std::vector<int>> grid;
+
+    LegacyLife(int r, int c) : rows(r), cols(c), grid(r, std::vector<int>(c, 0)) {
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                double x   = (double)rand() / RAND_MAX;
+                grid[i][j] = (x < 0.25) ? 1 : 0;
+            }
+        }
+    }
+
+    int countNeighbors(int r, int c) const {
+        int count = 0;
+        for (int dr = -1; dr <= 1; dr++) {
+            for (int dc = -1; dc <= 1; dc++) {
+                if (dr == 0 && dc == 0)
+                    continue;
+                int nr = r + dr;
+                int nc = c + dc;
+                if (nr >= 0 && nr < rows && nc >= 0 && nc < cols)
+                    if (grid[nr][nc] == 1)
+                        count++;
+            }
+        }
+        return count;
+    }
+
+    void step() {
+        std::vector<std::vector<int>> next = grid;
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
+                int n      = countNeighbors(i, j);
+                next[i][j] = grid[i][j] ? (n == 2 || n == 3) : (n == 3);
+            }
+        }
+        grid = next;
+    }
+
+    // Row headers + row payloads (ignores allocator overhead).
+    double bytesPerCell() const {
+        double bytes = (double)rows * sizeof(std::vector<int>) + (double)rows * cols * sizeof(int);
+        return bytes / ((double)rows * cols);
+    }
+};
+
+// Seconds spent running 'gens' steps of 'model'.
+template <typename Model>
+double timeSteps(Model& model, int gens) {
+    auto start = std::chrono::steady_clock::now();
+    for (int g = 0; g < gens; g++) model.step();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int gens               = 5;
+    std::vector<int> sizes = {1024, 8192};
+    int threads            = 1;
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("gens"))  gens  = args["gens"];
+    if (args.contains("sizes")) sizes = args["sizes"].get<std::vector<int>>();
+    if (args.contains("threads")) threads = args["threads"];
+
+    std::printf("flat board on %d thread%s\n", threads, threads == 1 ? "" : "s");
+    std::printf("%-8s %-8s %14s %12s\n", "board", "storage", "cells/sec", "bytes/cell");
+
+    for (int n : sizes) {
+        double cellsRun = (double)n * n * gens;
+
+        // Same seed for both boards so their results can be compared.
+        srand(2143);
+        LegacyLife legacy(n, n);
+        double legacySec = timeSteps(legacy, gens);
+
+        srand(2143);
+        ConwayLife flat(n, n);
+        flat.setThreads(threads);
+        double flatSec = timeSteps(flat, gens);
+
+        std::printf("%-8d %-8s %14.3e %12.2f\n", n, "legacy", cellsRun / legacySec, legacy.bytesPerCell());
+        std::printf("%-8d %-8s %14.3e %12.2f\n", n, "flat", cellsRun / flatSec, flat.bytesPerCell());
+        std::printf("%-8d speedup  %.2fx\n", n, legacySec / flatSec);
+
+        // Both layouts must reach the same generation.
+        GridView grid = flat.getGrid();
+        for (int r = 0; r < n; r++) {
+            for (int c = 0; c < n; c++) {
+                if (grid[r][c] != legacy.grid[r][c]) {
+                    std::printf("MISMATCH at (%d, %d)\n", r, c);
+                    return 1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
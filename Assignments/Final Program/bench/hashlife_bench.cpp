@@ -0,0 +1,129 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: hashlife_bench.cpp
+ *
+ * Description:
+ *    Runs classic long-lived patterns with
+ *    HashLife out to 2^maxPow generations and
+ *    reports the time, population and node count
+ *    at every power of two. The first 'checkGens'
+ *    generations are also run with the frontier
+ *    engine on a large dead board to check that
+ *    both agree cell for cell.
+ *
+ *    memoryMB caps the node table; a small value
+ *    exercises the garbage collector.
+ *
+ *    Usage: ./bench/hashlife_bench [maxPow=30] [checkGens=1000]
+ *               [memoryMB=512]
+ *               [patterns=["gosper_gun","acorn","r_pentomino"]]
+ * =========================================
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ConwayLife.hpp"
+#include "HashLife.hpp"
+#include "argsToJson.hpp"
+
+// Patterns as plaintext rows ('O' = alive). The entries in
+// shapes.json are simplified drawings, so the canonical forms
+// are kept here.
+const std::map<std::string, std::vector<std::string>> patterns = {
+    {"gosper_gun",
+     {"........................O...........",
+      "......................O.O...........",
+      "............OO......OO............OO",
+      "...........O...O....OO............OO",
+      "OO........O.....O...OO..............",
+      "OO........O...O.OO....O.O...........",
+      "..........O.....O.......O...........",
+      "...........O...O....................",
+      "............OO......................"}},
+    {"acorn", {".O.....", "...O...", "OO..OOO"}},
+    {"r_pentomino", {".OO", "OO.", ".O."}},
+};
+
+// Stamp 'rowsText' with its top-left at (row, col).
+void stamp(CellularAutomaton& model, const std::vector<std::string>& rowsText, int row, int col) {
+    for (size_t r = 0; r < rowsText.size(); r++)
+        for (size_t c = 0; c < rowsText[r].size(); c++)
+            if (rowsText[r][c] == 'O')
+                model.setCell(row + (int)r, col + (int)c, 1);
+}
+
+// Cell-for-cell comparison against the frontier engine.
+bool check(const std::vector<std::string>& shape, int gens) {
+    int size = 2 * gens + 200;  // nothing reaches the edge in 'gens' generations
+    ConwayLife ref(size, size);
+    HashLife hash(size, size);
+    ref.clear();
+    ref.setEngine("frontier");
+    stamp(ref, shape, size / 2, size / 2);
+    stamp(hash, shape, size / 2, size / 2);
+
+    ref.step(gens);
+    hash.advance(gens);
+
+    GridView a = ref.getGrid(), b = hash.getGrid();
+    for (int r = 0; r < size; r++)
+        for (int c = 0; c < size; c++)
+            if (a[r][c] != b[r][c])
+                return false;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int maxPow     = 30;
+    int checkGens  = 1000;
+    size_t memory  = 512;
+    std::vector<std::string> names = {"gosper_gun", "acorn", "r_pentomino"};
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("maxPow"))    maxPow    = args["maxPow"];
+    if (args.contains("checkGens")) checkGens = args["checkGens"];
+    if (args.contains("memoryMB"))  memory    = args["memoryMB"];
+    if (args.contains("patterns"))  names     = args["patterns"].get<std::vector<std::string>>();
+
+    bool ok = true;
+    for (const std::string& name : names) {
+        auto found = patterns.find(name);
+        if (found == patterns.end()) {
+            std::printf("%s: unknown pattern\n", name.c_str());
+            continue;
+        }
+
+        if (checkGens > 0) {
+            bool same = check(found->second, checkGens);
+            ok        = ok && same;
+            std::printf("%s: first %d generations %s the frontier engine\n", name.c_str(), checkGens,
+                        same ? "match" : "MISMATCH vs.");
+        }
+
+        HashLife hash(64, 64);
+        hash.setMemoryLimit(memory);
+        stamp(hash, found->second, 0, 0);
+
+        std::printf("%-12s %14s %12s %16s %10s\n", "pattern", "generation", "total ms", "population", "nodes");
+        auto start = std::chrono::steady_clock::now();
+        for (int k = 0; k <= maxPow; k++) {
+            // 2^k total: jump 1 first, then 2^(k-1) to double
+            hash.stepPow2(k == 0 ? 0 : k - 1);
+
+            auto now  = std::chrono::steady_clock::now();
+            double ms = std::chrono::duration<double, std::milli>(now - start).count();
+            std::printf("%-12s %14llu %12.2f %16llu %10zu\n", name.c_str(), (unsigned long long)hash.getGeneration(),
+                        ms, (unsigned long long)hash.getPopulation(), hash.nodeCount());
+        }
+        hash.printStats(std::cout);
+        std::printf("\n");
+    }
+
+    return ok ? 0 : 1;
+}
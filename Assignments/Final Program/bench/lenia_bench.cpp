@@ -0,0 +1,137 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: lenia_bench.cpp
+ *
+ * Description:
+ *    Times one Lenia step (FFT convolution) for
+ *    several kernel radii, field sizes and thread
+ *    counts. A direct (2R+1)^2 convolution is run
+ *    on a checkSize x checkSize field for each
+ *    radius and each of 'boundaries', both for
+ *    speed and as a reference: the largest
+ *    difference after 'checkGens' steps is printed
+ *    (float rounding only). A toroidal field of
+ *    power-of-two size is transformed as is; the
+ *    other boundaries take the padded path.
+ *
+ *    Usage: ./bench/lenia_bench [sizes=[512,2048]] [radii=[13,25,50]]
+ *               [threads=[1,4]] [gens=3] [checkSize=128] [checkGens=2]
+ *               [boundaries=["toroidal","dead","mirror"]]
+ * =========================================
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Lenia.hpp"
+#include "argsToJson.hpp"
+
+// One Lenia step by direct convolution on an n x n field; cells
+// outside it come from 'boundary' (haloSource, as Lenia pads).
+std::vector<float> directStep(const std::vector<float>& field, int n, const LeniaParams& params, Boundary boundary) {
+    const int R                 = params.radius;
+    const int side              = 2 * R + 1;
+    const float outside         = boundary == Boundary::Alive ? 1.0f : 0.0f;
+    std::vector<float> kernel   = Lenia::ringKernel(params);
+    std::vector<float> next(field.size());
+    auto source = [&](int i) { return i >= 0 && i < n ? i : haloSource(i, n, boundary); };
+
+    for (int r = 0; r < n; r++)
+        for (int c = 0; c < n; c++) {
+            double u = 0;
+            for (int dr = -R; dr <= R; dr++) {
+                int sr         = source(r + dr);
+                const float* k = &kernel[(size_t)(dr + R) * side + R];
+                for (int dc = -R; dc <= R; dc++) {
+                    int sc = source(c + dc);
+                    u += k[dc] * (sr < 0 || sc < 0 ? outside : field[(size_t)sr * n + sc]);
+                }
+            }
+            float v           = field[(size_t)r * n + c] + params.dt * Lenia::growth(params, (float)u);
+            next[(size_t)r * n + c] = std::min(1.0f, std::max(0.0f, v));
+        }
+    return next;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes              = {512, 2048};
+    std::vector<int> radii              = {13, 25, 50};
+    std::vector<int> threads            = {1};
+    int gens                            = 3;
+    int checkSize                       = 128;
+    int checkGens                       = 2;
+    std::vector<std::string> boundaries = {"toroidal", "dead", "mirror"};
+
+    if (defaultThreadCount() > 1)
+        threads.push_back(defaultThreadCount());
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("sizes"))      sizes      = args["sizes"].get<std::vector<int>>();
+    if (args.contains("radii"))      radii      = args["radii"].get<std::vector<int>>();
+    if (args.contains("threads"))    threads    = args["threads"].get<std::vector<int>>();
+    if (args.contains("gens"))       gens       = args["gens"];
+    if (args.contains("checkSize"))  checkSize  = args["checkSize"];
+    if (args.contains("checkGens"))  checkGens  = args["checkGens"];
+    if (args.contains("boundaries")) boundaries = args["boundaries"].get<std::vector<std::string>>();
+
+    bool ok = true;
+    std::printf("%-7s %-7s %-9s %-8s %12s %14s %10s\n", "radius", "field", "boundary", "method", "ms/step", "cells/sec",
+                "max diff");
+
+    for (int R : radii) {
+        LeniaParams params;
+        params.radius = R;
+
+        // Direct convolution: reference and O(N K^2) baseline
+        for (const std::string& name : boundaries) {
+            Boundary boundary = parseBoundary(name);
+            srand(2143);
+            Lenia small(checkSize, checkSize, params);
+            small.setBoundary(boundary);
+            std::vector<float> expected;
+            for (int r = 0; r < checkSize; r++)
+                for (int c = 0; c < checkSize; c++) expected.push_back(small.getValue(r, c));
+
+            auto start = std::chrono::steady_clock::now();
+            for (int g = 0; g < checkGens; g++) expected = directStep(expected, checkSize, params, boundary);
+            double sec = secondsSince(start) / checkGens;
+
+            small.step(checkGens);
+            double diff = 0;
+            for (int r = 0; r < checkSize; r++)
+                for (int c = 0; c < checkSize; c++)
+                    diff = std::max(diff,
+                                    (double)std::fabs(small.getValue(r, c) - expected[(size_t)r * checkSize + c]));
+            ok = ok && diff < 1e-3;
+            std::printf("%-7d %-7d %-9s %-8s %12.2f %14.3e %10.2e\n", R, checkSize, name.c_str(), "direct",
+                        sec * 1e3, (double)checkSize * checkSize / sec, diff);
+        }
+
+        for (int n : sizes)
+            for (int t : threads) {
+                srand(2143);
+                Lenia lenia(n, n, params);
+                lenia.setThreads(t);
+                lenia.step();  // builds the plan and kernel spectrum
+
+                auto start = std::chrono::steady_clock::now();
+                lenia.step(gens);
+                double sec = secondsSince(start) / gens;
+
+                std::string method = "fft x" + std::to_string(t);
+                std::printf("%-7d %-7d %-9s %-8s %12.2f %14.3e\n", R, n, boundaryName(lenia.getBoundary()),
+                            method.c_str(), sec * 1e3, (double)n * n / sec);
+            }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: ltl_bench.cpp
+ *
+ * Description:
+ *    Times the summed-area-table Larger-than-Life
+ *    step for several radii and thread counts, next
+ *    to a direct (2R+1)^2 count per cell. The rule
+ *    is Bosco's rule with its ranges scaled to the
+ *    box size, so every radius stays busy.
+ *
+ *    The first 'checkGens' generations on a
+ *    checkSize x checkSize board are compared cell
+ *    for cell with the direct count.
+ *
+ *    Usage: ./bench/ltl_bench [sizes=[512,2048]] [radii=[1,5,10,25,50]]
+ *               [threads=[1,4]] [gens=5] [checkSize=96] [checkGens=3]
+ * =========================================
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "LargerThanLife.hpp"
+#include "argsToJson.hpp"
+
+// Bosco's rule (R5) with its count ranges scaled to radius R.
+LtLRule scaledBosco(int R) {
+    double scale = (double)(2 * R + 1) * (2 * R + 1) / 121.0;
+    LtLRule rule = LtLRule::bosco();
+    rule.radius    = R;
+    rule.surviveLo = (int)(34 * scale + 0.5);
+    rule.surviveHi = (int)(58 * scale + 0.5);
+    rule.birthLo   = (int)(34 * scale + 0.5);
+    rule.birthHi   = (int)(45 * scale + 0.5);
+    return rule;
+}
+
+// One generation by counting every box directly (dead boundary).
+std::vector<uint8_t> directStep(const std::vector<uint8_t>& grid, int n, const LtLRule& rule) {
+    const int R = rule.radius;
+    std::vector<uint8_t> next(grid.size());
+
+    for (int r = 0; r < n; r++)
+        for (int c = 0; c < n; c++) {
+            int count = 0;
+            for (int rr = std::max(0, r - R); rr <= std::min(n - 1, r + R); rr++)
+                for (int cc = std::max(0, c - R); cc <= std::min(n - 1, c + R); cc++) count += grid[rr * n + cc] == 1;
+
+            uint8_t s = grid[r * n + c];
+            if (s == 1 && !rule.middle)
+                count--;
+            if (s == 0)
+                next[r * n + c] = count >= rule.birthLo && count <= rule.birthHi;
+            else
+                next[r * n + c] = s == 1 && count >= rule.surviveLo && count <= rule.surviveHi;
+        }
+    return next;
+}
+
+std::vector<uint8_t> copyGrid(const CellularAutomaton& model) {
+    GridView grid = model.getGrid();
+    std::vector<uint8_t> out;
+    for (int r = 0; r < grid.rowCount(); r++)
+        for (uint8_t cell : grid[r]) out.push_back(cell);
+    return out;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes   = {512, 2048};
+    std::vector<int> radii   = {1, 5, 10, 25, 50};
+    std::vector<int> threads = {1};
+    int gens                 = 5;
+    int checkSize            = 96;
+    int checkGens            = 3;
+
+    if (defaultThreadCount() > 1)
+        threads.push_back(defaultThreadCount());
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("sizes"))     sizes     = args["sizes"].get<std::vector<int>>();
+    if (args.contains("radii"))     radii     = args["radii"].get<std::vector<int>>();
+    if (args.contains("threads"))   threads   = args["threads"].get<std::vector<int>>();
+    if (args.contains("gens"))      gens      = args["gens"];
+    if (args.contains("checkSize")) checkSize = args["checkSize"];
+    if (args.contains("checkGens")) checkGens = args["checkGens"];
+
+    bool ok = true;
+    std::printf("%-7s %-7s %-8s %14s %8s\n", "radius", "board", "method", "cells/sec", "check");
+
+    for (int R : radii) {
+        LtLRule rule = scaledBosco(R);
+
+        // Direct count: correctness reference and speed baseline
+        srand(2143);
+        LargerThanLife small(checkSize, checkSize, rule);
+        small.randomize(0.5);
+        std::vector<uint8_t> expected = copyGrid(small);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int g = 0; g < checkGens; g++) expected = directStep(expected, checkSize, rule);
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        small.step(checkGens);
+        bool same = copyGrid(small) == expected;
+        ok        = ok && same;
+        std::printf("%-7d %-7d %-8s %14.3e %8s\n", R, checkSize, "direct", (double)checkSize * checkSize * checkGens / sec,
+                    same ? "match" : "MISMATCH");
+
+        for (int n : sizes)
+            for (int t : threads) {
+                srand(2143);
+                LargerThanLife ltl(n, n, rule);
+                ltl.randomize(0.5);
+                ltl.setThreads(t);
+
+                start = std::chrono::steady_clock::now();
+                ltl.step(gens);
+                sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+                std::string method = "sat x" + std::to_string(t);
+                std::printf("%-7d %-7d %-8s %14.3e\n", R, n, method.c_str(), (double)n * n * gens / sec);
+            }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: memory_bench.cpp
+ *
+ * Description:
+ *    Row-band ConwayLife on boards far larger than
+ *    the caches, with the cell buffers on the heap
+ *    or in first-touch huge pages, and the workers
+ *    unpinned or pinned. Reports cell-updates per
+ *    second, the memory bandwidth that implies (one
+ *    read of the front buffer and one write of the
+ *    back buffer per generation), data-TLB read
+ *    misses per million cells (Linux perf counters;
+ *    "n/a" where perf_event_open is not allowed),
+ *    and how much of the process is actually backed
+ *    by transparent huge pages.
+ *
+ *    Every result is checked against the first
+ *    configuration for the same board.
+ *
+ *    Usage: ./bench/memory_bench [sizes=[16384,32768]]
+ *               [memory=["heap","huge"]]
+ *               [pin=["none","spread"]] [threads=N]
+ *               [engine="simd"] [gens=4]
+ * =========================================
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ConwayLife.hpp"
+#include "argsToJson.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// --------------------------------------------------------------
+// TlbCounter: data-TLB read misses of this process and of every
+// thread it starts afterwards (the pool workers). Inherited
+// counts are only added in when those threads exit, so read
+// misses() after the model (and its pool) is gone.
+// --------------------------------------------------------------
+class TlbCounter {
+   private:
+    int fd = -1;
+
+   public:
+    TlbCounter() {
+#if defined(__linux__)
+        perf_event_attr attr{};
+        attr.size           = sizeof attr;
+        attr.type           = PERF_TYPE_HW_CACHE;
+        attr.config         = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled       = 1;
+        attr.inherit        = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        fd                  = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+    ~TlbCounter() {
+#if defined(__linux__)
+        if (fd >= 0)
+            close(fd);
+#endif
+    }
+
+    void start() {
+#if defined(__linux__)
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+    void stop() {
+#if defined(__linux__)
+        if (fd >= 0)
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+#endif
+    }
+    long long misses() const {
+        long long count = -1;
+#if defined(__linux__)
+        if (fd >= 0 && read(fd, &count, sizeof count) != (ssize_t)sizeof count)
+            count = -1;
+#endif
+        return count;
+    }
+};
+
+// AnonHugePages of this process in MB (-1 if unknown).
+long hugePageMB() {
+    std::ifstream smaps("/proc/self/smaps_rollup");
+    std::string line;
+    while (std::getline(smaps, line))
+        if (line.rfind("AnonHugePages:", 0) == 0)
+            return std::stol(line.substr(14)) / 1024;
+    return -1;
+}
+
+// FNV-1a over the visible cells.
+uint64_t gridHash(const GridView& grid) {
+    uint64_t h = 1469598103934665603ull;
+    for (int r = 0; r < grid.rowCount(); r++)
+        for (uint8_t cell : grid[r]) h = (h ^ cell) * 1099511628211ull;
+    return h;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes                = {16384, 32768};
+    std::vector<std::string> memoryModes  = {"heap", "huge"};
+    std::vector<std::string> pinningModes = {"none", "spread"};
+    int threads                           = defaultThreadCount();
+    std::string engineName                = "simd";
+    int gens                              = 4;
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("sizes"))   sizes        = args["sizes"].get<std::vector<int>>();
+    if (args.contains("memory"))  memoryModes  = args["memory"].get<std::vector<std::string>>();
+    if (args.contains("pin"))     pinningModes = args["pin"].get<std::vector<std::string>>();
+    if (args.contains("threads")) threads      = args["threads"];
+    if (args.contains("engine"))  engineName   = args["engine"];
+    if (args.contains("gens"))    gens         = args["gens"];
+
+    bool ok = true;
+    std::printf("%s, %d threads, %d generations\n%-7s %-6s %-8s %14s %9s %14s %8s %8s\n", engineName.c_str(),
+                threads, gens, "board", "memory", "pinning", "cells/sec", "GB/s", "dTLB miss/Mc", "hugeMB", "check");
+
+    for (int n : sizes) {
+        bool first         = true;
+        uint64_t reference = 0;
+
+        for (const std::string& memoryName : memoryModes)
+            for (const std::string& pinName : pinningModes) {
+                TlbCounter tlb;  // before the pool exists, so its workers inherit it
+                double sec, bytes;
+                long huge;
+                uint64_t hash;
+                {
+                    srand(2143);
+                    ConwayLife gol(n, n);
+                    gol.setEngine(engineName);
+                    gol.setThreads(threads);
+                    gol.setPinning(parseCpuPinning(pinName));
+                    GridMemory memory = parseGridMemory(memoryName);
+                    if (memory != GridMemory::Heap)  // heap: buffers as the constructor made them
+                        gol.setMemory(memory);
+                    gol.step();  // warm-up: halos written, band engines built
+
+                    tlb.start();
+                    auto start = std::chrono::steady_clock::now();
+                    gol.step(gens);
+                    sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    tlb.stop();
+
+                    bytes = 2.0 * gol.layout().bufferSize() * gens;
+                    huge  = hugePageMB();
+                    hash  = gridHash(gol.getGrid());
+                }
+                long long misses = tlb.misses();
+
+                bool same = first || hash == reference;
+                ok        = ok && same;
+                if (first)
+                    reference = hash;
+
+                char missText[24] = "n/a";
+                if (misses >= 0)
+                    std::snprintf(missText, sizeof missText, "%.1f", misses / ((double)n * n * gens / 1e6));
+                std::printf("%-7d %-6s %-8s %14.3e %9.2f %14s %8ld %8s\n", n, memoryName.c_str(), pinName.c_str(),
+                            (double)n * n * gens / sec, bytes / sec / 1e9, missText, huge,
+                            first ? "" : same ? "match" : "MISMATCH");
+                first = false;
+            }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: soup_search_bench.cpp
+ *
+ * Description:
+ *    Headless soup search: 'soups' random 16x16
+ *    soups, each run until it stabilizes and split
+ *    into still lifes, oscillators and spaceships
+ *    (SoupSearch), counted in one census. Runs once
+ *    per entry of 'threads' (every thread keeps its
+ *    own census, merged at the end) and reports
+ *    soups/sec and soups/sec per core; every run
+ *    must produce the same census. First checks that
+ *    a known soup splits into the objects it should.
+ *
+ *    Prints the 'top' most common objects; out=file
+ *    also writes the census with the run's settings
+ *    as JSON (out="-": to standard output).
+ *
+ *    Usage: ./bench/soup_search_bench [soups=10000]
+ *               [seed=1] [threads=[1,2,4]]
+ *               [rule="B3/S23"] [soupSize=16]
+ *               [maxGens=20000] [maxPeriod=60]
+ *               [top=20] [out=""]
+ * =========================================
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "SoupSearch.hpp"
+#include "argsToJson.hpp"
+
+int main(int argc, char* argv[]) {
+    long long soups      = 10000;
+    uint64_t seed        = 1;
+    std::string ruleText = "B3/S23";
+    int soupSize         = 16;
+    int maxGens          = 20000;
+    int maxPeriod        = 60;
+    int top              = 20;
+    std::string out      = "";
+    std::vector<int> threads;
+
+    for (int t = 1; t < defaultThreadCount(); t *= 2) threads.push_back(t);
+    threads.push_back(defaultThreadCount());
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("soups"))     soups     = args["soups"];
+    if (args.contains("seed"))      seed      = args["seed"];
+    if (args.contains("threads"))   threads   = args["threads"].get<std::vector<int>>();
+    if (args.contains("rule"))      ruleText  = args["rule"];
+    if (args.contains("soupSize"))  soupSize  = args["soupSize"];
+    if (args.contains("maxGens"))   maxGens   = args["maxGens"];
+    if (args.contains("maxPeriod")) maxPeriod = args["maxPeriod"];
+    if (args.contains("top"))       top       = args["top"];
+    if (args.contains("out"))       out       = args["out"];
+
+    SoupSearch search(LifeRule::parse(ruleText), soupSize);
+    search.setSeed(seed);
+    search.setMaxGenerations(maxGens);
+    search.setMaxPeriod(maxPeriod);
+
+    // With out="-" the JSON owns standard output
+    FILE* report = out == "-" ? stderr : stdout;
+
+    // Regression: B3/S23 soup 2253 of seed 1 ends as one pulsar (its
+    // four quarters do not evolve on their own) next to a beehive
+    SoupSearch known;
+    SoupCensus pulsar = known.run(2253, 1);
+    auto found        = pulsar.objects.find("xp3_co9nas0san9oczgoldlo0oldlogz1047210127401");
+    bool ok           = found != pulsar.objects.end() && found->second.count == 1 && pulsar.oscillators == 3;
+    std::fprintf(report, "pulsar check (seed 1, soup 2253): %s\n", ok ? "ok" : "FAILED");
+    std::fprintf(report, "%lld %dx%d soups, %s, seed %llu, %dx%d board\n%8s %12s %16s %10s %8s\n", soups, soupSize,
+                 soupSize, search.getRule().toString().c_str(), (unsigned long long)seed, SOUP_SIZE, SOUP_SIZE,
+                 "threads", "soups/sec", "soups/sec/core", "gens/soup", "check");
+
+    SoupCensus census;
+    double sec = 0;
+    for (size_t i = 0; i < threads.size(); i++) {
+        search.setThreads(threads[i]);
+        auto start        = std::chrono::steady_clock::now();
+        SoupCensus result = search.run(0, soups);
+        sec               = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        bool same = i == 0 || result == census;
+        ok        = ok && same;
+        census    = std::move(result);
+        std::fprintf(report, "%8d %12.1f %16.1f %10.1f %8s\n", threads[i], soups / sec, soups / sec / threads[i],
+                     (double)census.generations / soups, i == 0 ? "" : same ? "match" : "MISMATCH");
+    }
+
+    std::fprintf(report, "\n%lld stabilized, %lld reached the edge, %lld unstable\n", census.stabilized(),
+                 census.reachedEdge, census.unstable);
+    std::fprintf(report, "%lld still lifes, %lld oscillators, %lld spaceships in %zu kinds\n\n%-24s %10s %10s %8s\n",
+                 census.stillLifes, census.oscillators, census.spaceships, census.objects.size(), "object", "count",
+                 "per soup", "sample");
+    std::vector<std::pair<std::string, SoupCensus::Entry>> ranked = census.ranked();
+    for (int i = 0; i < std::min(top, (int)ranked.size()); i++)
+        std::fprintf(report, "%-24s %10lld %10.4f %8lld\n", ranked[i].first.c_str(), ranked[i].second.count,
+                     (double)ranked[i].second.count / soups, ranked[i].second.sample);
+
+    if (out.empty())
+        return ok ? 0 : 1;
+
+    // Census plus the settings and speed of the last run
+    json result                     = census.toJson();
+    result["rule"]                  = search.getRule().toString();
+    result["seed"]                  = seed;
+    result["soupSize"]              = soupSize;
+    result["board"]                 = SOUP_SIZE;
+    result["maxGens"]               = maxGens;
+    result["maxPeriod"]             = maxPeriod;
+    result["threads"]               = threads.back();
+    result["seconds"]               = sec;
+    result["soupsPerSecond"]        = soups / sec;
+    result["soupsPerSecondPerCore"] = soups / sec / threads.back();
+
+    if (out == "-") {
+        std::cout << result.dump(2) << "\n";
+    } else {
+        std::ofstream file(out);
+        file << result.dump(2) << "\n";
+        std::fprintf(report, "\ncensus written to %s\n", out.c_str());
+    }
+
+    return ok ? 0 : 1;
+}
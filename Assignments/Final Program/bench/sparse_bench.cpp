@@ -0,0 +1,92 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: sparse_bench.cpp
+ *
+ * Description:
+ *    Runs one small pattern from shapes.json
+ *    (diehard, acorn, r_pentomino, ...) in the
+ *    middle of a huge empty board and reports the
+ *    time per generation of each engine. Engines
+ *    that follow activity (frontier, tiles) should
+ *    not care how big the board is. Timing starts
+ *    after one warm-up generation and covers one
+ *    step(gens) call.
+ *
+ *    engine "sparse" runs the unbounded SparseLife
+ *    universe instead (its viewport is the same
+ *    size x size window), which only stores the
+ *    64x64 chunks that hold live cells.
+ *
+ *    Usage: ./bench/sparse_bench [size=10000] [gens=500]
+ *               [patterns=["diehard","acorn","r_pentomino"]]
+ *               [engines=["frontier","tiles","sparse"]]
+ * =========================================
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ConwayLife.hpp"
+#include "Patterns.hpp"
+#include "SparseLife.hpp"
+#include "argsToJson.hpp"
+
+int main(int argc, char* argv[]) {
+    int size                         = 10000;
+    int gens                         = 500;
+    std::vector<std::string> shapes  = {"diehard", "acorn", "r_pentomino"};
+    std::vector<std::string> engines = {"frontier", "tiles", "sparse"};
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("size"))     size    = args["size"];
+    if (args.contains("gens"))     gens    = args["gens"];
+    if (args.contains("patterns")) shapes  = args["patterns"].get<std::vector<std::string>>();
+    if (args.contains("engines"))  engines = args["engines"].get<std::vector<std::string>>();
+
+    json patterns = loadPatterns("Assets/shapes.json");
+
+    std::printf("%-12s %-10s %12s %12s\n", "pattern", "engine", "us/gen", "population");
+
+    for (const std::string& shape : shapes) {
+        for (const std::string& name : engines) {
+            std::unique_ptr<CellularAutomaton> model;
+            if (name == "sparse") {
+                model = std::make_unique<SparseLife>(size, size);
+            } else {
+                auto gol = std::make_unique<ConwayLife>(size, size);
+                gol->clear();
+                gol->setEngine(name);
+                model = std::move(gol);
+            }
+
+            if (!stampPattern(*model, patterns, shape, size / 2, size / 2)) {
+                std::printf("%-12s not found in Assets/shapes.json\n", shape.c_str());
+                break;
+            }
+
+            // The first generation after an edit scans the whole board
+            model->step();
+
+            auto start = std::chrono::steady_clock::now();
+            model->step(gens);
+            auto stop = std::chrono::steady_clock::now();
+            double us = std::chrono::duration<double, std::micro>(stop - start).count() / gens;
+
+            // Population check (all engines must agree)
+            long population = 0;
+            GridView grid   = model->getGrid();
+            for (int r = 0; r < size; r++)
+                for (uint8_t cell : grid[r]) population += cell;
+
+            std::printf("%-12s %-10s %12.2f %12ld\n", shape.c_str(), name.c_str(), us, population);
+            model->printStats(std::cout);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: temporal_bench.cpp
+ *
+ * Description:
+ *    The bit-packed engine (one pass over memory per
+ *    generation) vs. the temporally blocked one at
+ *    several depths (one pass per 'depth' generations),
+ *    on packed boards only, so packing and the byte
+ *    grid are left out of the time. Boards larger than
+ *    the last-level cache are where blocking pays off.
+ *    Each result is checked against the bit-packed one.
+ *
+ *    Usage: ./bench/temporal_bench [sizes=[4096,16384,32768]]
+ *               [depths=[1,4,8,16,32]] [gens=64]
+ *               [boundary=dead] [rule="B3/S23"]
+ * =========================================
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "TemporalBlockEngine.hpp"
+#include "argsToJson.hpp"
+
+template <typename Engine>
+double timeAdvance(Engine& engine, int gens, Boundary b) {
+    auto start = std::chrono::steady_clock::now();
+    engine.advance(gens, b);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes  = {4096, 16384, 32768};
+    std::vector<int> depths = {1, 4, 8, 16, 32};
+    int gens                = 64;
+    Boundary boundary       = Boundary::Dead;
+    std::string ruleText    = "B3/S23";
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("sizes"))    sizes    = args["sizes"].get<std::vector<int>>();
+    if (args.contains("depths"))   depths   = args["depths"].get<std::vector<int>>();
+    if (args.contains("gens"))     gens     = args["gens"];
+    if (args.contains("boundary")) boundary = parseBoundary(args["boundary"]);
+    if (args.contains("rule"))     ruleText = args["rule"];
+
+    LifeRule rule = LifeRule::parse(ruleText);
+    bool ok       = true;
+    std::printf("rule %s, %d generations\n%-7s %-12s %6s %14s %9s %8s\n", rule.toString().c_str(), gens, "board",
+                "engine", "depth", "cells/sec", "speedup", "check");
+
+    for (int n : sizes) {
+        double cellsRun = (double)n * n * gens;
+        std::vector<uint8_t> grid((size_t)n * n), result((size_t)n * n), expected((size_t)n * n);
+        srand(2143);
+        for (uint8_t& cell : grid) cell = rand() % 4 == 0;
+        GridView start(grid.data(), n, n, n);
+
+        double baseSec;
+        {
+            BitPackedEngine plain(rule);
+            plain.pack(start);
+            baseSec = timeAdvance(plain, gens, boundary);
+            plain.unpack(expected.data(), n);
+        }
+        std::printf("%-7d %-12s %6d %14.3e %8.2fx %8s\n", n, "bitpacked", 1, cellsRun / baseSec, 1.0, "");
+
+        for (int depth : depths) {
+            TemporalBlockEngine blocked(rule, depth);
+            blocked.pack(start);
+            double sec = timeAdvance(blocked, gens, boundary);
+            blocked.unpack(result.data(), n);
+
+            bool same = result == expected;
+            ok        = ok && same;
+            std::printf("%-7d %-12s %6d %14.3e %8.2fx %8s\n", n, "blocked", depth, cellsRun / sec, baseSec / sec,
+                        same ? "match" : "MISMATCH");
+        }
+    }
+
+    return ok ? 0 : 1;
+}
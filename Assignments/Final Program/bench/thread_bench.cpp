@@ -0,0 +1,136 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: thread_bench.cpp
+ *
+ * Description:
+ *    Multi-threaded ConwayLife: cell-updates per
+ *    second with 1, 2, 4, ... threads up to every
+ *    hardware thread, the speedup over one thread,
+ *    and a check that each result equals the
+ *    single-threaded board bit for bit.
+ *
+ *    simd / runningsum step row bands; tiles spreads
+ *    its active tiles with work stealing. 'live' is
+ *    the fraction of the board that starts populated
+ *    (a square in the top-left corner), so live=0.1
+ *    leaves 90% of it dead. For tiles, 'balance' is
+ *    the least busy worker's busy time over the
+ *    busiest one's (1 = perfectly even).
+ *
+ *    Usage: ./bench/thread_bench [sizes=[4096,16384]]
+ *               [threads=[1,2,4]] [live=[1,0.1]]
+ *               [engines=["simd","runningsum","tiles"]]
+ *               [gens=10] [boundary=dead]
+ *
+ *    threads defaults to powers of two up to the
+ *    hardware thread count (plus the count itself).
+ * =========================================
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "ConwayLife.hpp"
+#include "argsToJson.hpp"
+
+bool sameGrid(const GridView& a, const GridView& b) {
+    for (int r = 0; r < a.rowCount(); r++)
+        for (int c = 0; c < a.colCount(); c++)
+            if (a[r][c] != b[r][c])
+                return false;
+    return true;
+}
+
+// 25% random soup over the top-left 'live' fraction of an n x n board.
+void seed(ConwayLife& gol, int n, double live) {
+    int side = (int)std::lround(n * std::sqrt(live));
+    srand(2143);
+    gol.randomize(0);
+    for (int r = 0; r < side; r++)
+        for (int c = 0; c < side; c++) gol.setCell(r, c, rand() % 4 == 0);
+}
+
+// Least busy worker / busiest worker (tiles only; 0 if unknown).
+double balance(const ConwayLife& gol) {
+    auto* tiles = dynamic_cast<const ActiveTileEngine*>(gol.getEngine());
+    if (!tiles || tiles->workerStats().empty())
+        return 0;
+    double least = 1e300, most = 0;
+    for (const WorkStealingScheduler::WorkerStats& s : tiles->workerStats()) {
+        least = std::min(least, s.busy);
+        most  = std::max(most, s.busy);
+    }
+    return most > 0 ? least / most : 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes           = {4096, 16384};
+    std::vector<std::string> engines = {"simd", "runningsum", "tiles"};
+    std::vector<double> lives        = {1, 0.1};
+    std::vector<int> threads;
+    int gens          = 10;
+    Boundary boundary = Boundary::Dead;
+
+    for (int t = 1; t < defaultThreadCount(); t *= 2) threads.push_back(t);
+    threads.push_back(defaultThreadCount());
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("sizes"))    sizes    = args["sizes"].get<std::vector<int>>();
+    if (args.contains("threads"))  threads  = args["threads"].get<std::vector<int>>();
+    if (args.contains("live"))     lives    = args["live"].get<std::vector<double>>();
+    if (args.contains("engines"))  engines  = args["engines"].get<std::vector<std::string>>();
+    if (args.contains("gens"))     gens     = args["gens"];
+    if (args.contains("boundary")) boundary = parseBoundary(args["boundary"]);
+
+    bool ok = true;
+    std::printf("%d hardware threads\n%-7s %5s %-12s %8s %14s %9s %8s %8s\n", defaultThreadCount(), "board", "live",
+                "engine", "threads", "cells/sec", "speedup", "balance", "check");
+
+    for (int n : sizes)
+        for (double live : lives)
+            for (const std::string& name : engines) {
+                // One thread is the reference for both time and cells
+                ConwayLife reference(n, n);
+                seed(reference, n, live);
+                reference.setEngine(name);
+                reference.setBoundary(boundary);
+                reference.setThreads(1);
+
+                auto start = std::chrono::steady_clock::now();
+                reference.step(gens);
+                double baseSec  = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                double cellsRun = (double)n * n * gens;
+
+                for (int t : threads) {
+                    double sec = baseSec, even = 0;
+                    bool same  = true;
+                    if (t > 1) {
+                        ConwayLife gol(n, n);
+                        seed(gol, n, live);
+                        gol.setEngine(name);
+                        gol.setBoundary(boundary);
+                        gol.setThreads(t);
+
+                        start = std::chrono::steady_clock::now();
+                        gol.step(gens);
+                        sec  = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                        even = balance(gol);
+                        same = sameGrid(gol.getGrid(), reference.getGrid());
+                        ok   = ok && same;
+                    }
+
+                    char evenText[16] = "";
+                    if (even > 0)
+                        std::snprintf(evenText, sizeof evenText, "%.2f", even);
+                    std::printf("%-7d %5.2f %-12s %8d %14.3e %8.2fx %8s %8s\n", n, live, name.c_str(), t,
+                                cellsRun / sec, baseSec / sec, evenText, t == 1 ? "" : same ? "match" : "MISMATCH");
+                }
+            }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: turmite_bench.cpp
+ *
+ * Description:
+ *    Time to run Langton's ant (or any turmite)
+ *    out to 10^6 .. 10^12 steps with the transit
+ *    memo and highway jumps, next to the memo alone
+ *    and plain stepping for 'checkSteps', which must
+ *    leave the ant and the cells around it the same.
+ *    A universe of 'ants' ants is timed the same way
+ *    (a tick moves every ant once).
+ *
+ *    Usage: ./bench/turmite_bench [rule="RL"]
+ *               [steps=[1e6,1e8,1e9,1e12]]
+ *               [checkSteps=10000000] [ants=16]
+ * =========================================
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Turmite.hpp"
+#include "argsToJson.hpp"
+
+enum class Mode { Plain, Memo, Full };
+const char* modeName[] = {"plain", "memo", "memo+highway"};
+
+// Ants spread over a 4000 x 4000 square (same layout every run).
+void addAnts(Turmites& t, int count) {
+    t.clearAnts();
+    srand(2143);
+    for (int i = 0; i < count; i++) t.addAnt(rand() % 4000 - 2000, rand() % 4000 - 2000, rand() % 4);
+}
+
+double run(Turmites& t, Mode mode, uint64_t steps) {
+    t.setMemoize(mode != Mode::Plain);
+    t.setFastForward(mode == Mode::Full);
+    auto start = std::chrono::steady_clock::now();
+    t.advance(steps);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Same ants, and the same cells within 64 of each ant.
+bool sameState(const Turmites& a, const Turmites& b) {
+    if (a.getAnts().size() != b.getAnts().size())
+        return false;
+    for (size_t i = 0; i < a.getAnts().size(); i++) {
+        const Turmites::Ant &x = a.getAnts()[i], &y = b.getAnts()[i];
+        if (x.row != y.row || x.col != y.col || x.dir != y.dir || x.state != y.state)
+            return false;
+        for (int64_t r = x.row - 64; r <= x.row + 64; r++)
+            for (int64_t c = x.col - 64; c <= x.col + 64; c++)
+                if (a.getUniverseCell(r, c) != b.getUniverseCell(r, c))
+                    return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string ruleText        = "RL";
+    std::vector<double> steps   = {1e6, 1e8, 1e9, 1e12};
+    uint64_t checkSteps         = 10000000;
+    int antCount                = 16;
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("rule"))       ruleText   = args["rule"];
+    if (args.contains("steps"))      steps      = args["steps"].get<std::vector<double>>();
+    if (args.contains("checkSteps")) checkSteps = args["checkSteps"].get<uint64_t>();
+    if (args.contains("ants"))       antCount   = args["ants"];
+
+    TurmiteRule rule = TurmiteRule::parse(ruleText);
+    bool ok          = true;
+
+    std::printf("rule %s\n%-14s %6s %14s %12s %12s %8s\n", rule.toString().c_str(), "mode", "ants", "ticks",
+                "seconds", "ticks/sec", "check");
+
+    // Each mode for 'checkSteps', checked against plain stepping
+    for (int ants : {1, antCount}) {
+        Turmites plain(1, 1, rule);
+        if (ants > 1)
+            addAnts(plain, ants);
+        double base = run(plain, Mode::Plain, checkSteps);
+        std::printf("%-14s %6d %14llu %12.3f %12.3e %8s\n", modeName[0], ants, (unsigned long long)checkSteps, base,
+                    checkSteps / base, "");
+
+        for (Mode mode : {Mode::Memo, Mode::Full}) {
+            Turmites t(1, 1, rule);
+            if (ants > 1)
+                addAnts(t, ants);
+            double sec = run(t, mode, checkSteps);
+            bool same  = sameState(t, plain);
+            ok         = ok && same;
+            std::printf("%-14s %6d %14llu %12.3f %12.3e %8s\n", modeName[(int)mode], ants,
+                        (unsigned long long)checkSteps, sec, checkSteps / sec, same ? "match" : "MISMATCH");
+        }
+    }
+
+    // The long runs, one ant
+    for (double s : steps) {
+        Turmites t(1, 1, rule);
+        uint64_t n = (uint64_t)s;
+        double sec = run(t, Mode::Full, n);
+        std::printf("%-14s %6d %14llu %12.3f %12.3e %8s\n", modeName[2], 1, (unsigned long long)n, sec, n / sec, "");
+        t.printStats(std::cout);
+    }
+
+    return ok ? 0 : 1;
+}
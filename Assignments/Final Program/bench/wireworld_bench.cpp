@@ -0,0 +1,114 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: wireworld_bench.cpp
+ *
+ * Description:
+ *    Wireworld event lists vs. a full-grid scan.
+ *    The board is tiled with copies of 'circuit'
+ *    (default: the clock in Assets); only the
+ *    fraction 'active' of them keep their electron,
+ *    the rest are idle copper. Prints the time per
+ *    tick of both and checks they end identical.
+ *
+ *    Usage: ./bench/wireworld_bench [sizes=[1024,4096]]
+ *               [active=[1,0.1,0.01]] [gens=200]
+ *               [circuit="Assets/wireworld_clock.txt"]
+ * =========================================
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Wireworld.hpp"
+#include "argsToJson.hpp"
+
+// One tick over every cell (dead edges), 'cur' -> 'next'.
+void scanStep(const std::vector<uint8_t>& cur, std::vector<uint8_t>& next, int n) {
+    for (int r = 0; r < n; r++)
+        for (int c = 0; c < n; c++) {
+            uint8_t s = cur[(size_t)r * n + c], out = s;
+            if (s == Wireworld::Head)
+                out = Wireworld::Tail;
+            else if (s == Wireworld::Tail)
+                out = Wireworld::Conductor;
+            else if (s == Wireworld::Conductor) {
+                int heads = 0;
+                for (int dr = -1; dr <= 1; dr++)
+                    for (int dc = -1; dc <= 1; dc++) {
+                        int rr = r + dr, cc = c + dc;
+                        heads += rr >= 0 && rr < n && cc >= 0 && cc < n && cur[(size_t)rr * n + cc] == Wireworld::Head;
+                    }
+                if (heads == 1 || heads == 2)
+                    out = Wireworld::Head;
+            }
+            next[(size_t)r * n + c] = out;
+        }
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes     = {1024, 4096};
+    std::vector<double> active = {1, 0.1, 0.01};
+    int gens                   = 200;
+    std::string circuit        = "Assets/wireworld_clock.txt";
+
+    json args = ArgsToJson(argc, argv);
+    if (args.contains("sizes"))   sizes   = args["sizes"].get<std::vector<int>>();
+    if (args.contains("active"))  active  = args["active"].get<std::vector<double>>();
+    if (args.contains("gens"))    gens    = args["gens"];
+    if (args.contains("circuit")) circuit = args["circuit"];
+
+    WireworldPattern tile = WireworldPattern::load(circuit);
+    bool ok               = true;
+
+    std::printf("%-7s %7s %9s %14s %14s %9s %8s\n", "size", "active", "heads", "events us/tick", "scan us/tick",
+                "speedup", "check");
+
+    for (int n : sizes)
+        for (double fraction : active) {
+            // Tile the board; idle copies lose their electrons
+            srand(2143);
+            Wireworld world(n, n);
+            WireworldPattern idle = tile;
+            for (uint8_t& s : idle.cells)
+                if (s == Wireworld::Head || s == Wireworld::Tail)
+                    s = Wireworld::Conductor;
+            for (int top = 0; top + tile.rows <= n; top += tile.rows + 1)
+                for (int left = 0; left + tile.cols <= n; left += tile.cols + 1)
+                    world.place((double)rand() / RAND_MAX < fraction ? tile : idle, top, left);
+
+            std::vector<uint8_t> cur((size_t)n * n), next(cur.size());
+            for (int r = 0; r < n; r++)
+                for (int c = 0; c < n; c++) cur[(size_t)r * n + c] = (uint8_t)world.getCell(r, c);
+
+            world.step();  // builds the lists (one scan)
+            scanStep(cur, next, n);
+            cur.swap(next);
+            size_t heads = world.headCount();
+
+            auto start = std::chrono::steady_clock::now();
+            for (int g = 1; g < gens; g++) world.step();
+            double events = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            start = std::chrono::steady_clock::now();
+            for (int g = 1; g < gens; g++) {
+                scanStep(cur, next, n);
+                cur.swap(next);
+            }
+            double scan = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            bool same = true;
+            for (int r = 0; r < n && same; r++)
+                for (int c = 0; c < n && same; c++) same = world.getCell(r, c) == cur[(size_t)r * n + c];
+            ok = ok && same;
+
+            double ticks = std::max(1, gens - 1);
+            std::printf("%-7d %7.2f %9zu %14.1f %14.1f %8.1fx %8s\n", n, fraction, heads, events / ticks * 1e6,
+                        scan / ticks * 1e6, scan / events, same ? "match" : "MISMATCH");
+        }
+
+    return ok ? 0 : 1;
+}
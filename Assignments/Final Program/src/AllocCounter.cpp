@@ -0,0 +1,47 @@
+/**
+ * =========================================
+ * Name: Nicole Vigilant
+ * Program 03 - SDL Game of Life
+ * File: AllocCounter.cpp
+ *
+ * Description:
+ *    Replaces the global operator new/delete with
+ *    versions that count every allocation. See
+ *    AllocCounter.hpp for how it is used.
+ * =========================================
+ */
+
+#include "AllocCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<size_t> allocations{0};
+static thread_local size_t threadAllocations = 0;
+
+size_t allocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+size_t threadAllocationCount() {
+    return threadAllocations;
+}
+
+// new[], nothrow new, etc. all forward to this one in the standard library
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    threadAllocations++;
+
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
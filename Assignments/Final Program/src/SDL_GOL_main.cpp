@@ -6,25 +6,58 @@
  *
  * Description:
  *    Main SDL driver for Conway’s Game of Life.
+ *    model=hashlife or model=sparse runs an
+ *    unbounded universe instead; the window shows
+ *    its viewport. model=generations runs a
+ *    Generations rule (default Brian's Brain),
+ *    model=ltl a Larger-than-Life rule (default
+ *    Bosco's rule; radius/birth/survive/middle
+ *    override its fields), model=lenia a
+ *    continuous Lenia field (default Orbium;
+ *    radius/mu/sigma/dt/peaks), and
+ *    model=elementary a Wolfram 1D rule (rule=30)
+ *    drawn as a scrolling space-time diagram, and
+ *    model=turmite Langton's ant or another turmite
+ *    (rule=RL; ants=N ants) on an unbounded plane,
+ *    and model=wireworld a Wireworld circuit loaded
+ *    from a text file (pattern=...).
  *    Supports:
  *      - Pause (SPACE)
  *      - Step once (N)
  *      - Clear (C)
  *      - Randomize (R)
+ *      - Print engine / model stats (S)
  *      - Quit (Q or ESC)
  *      - Mouse click toggles cells
  *      - Load "glider" with key 1 at mouse position
+ *    The model steps on its own thread and hands
+ *    finished generations to the render loop through
+ *    a triple buffer; input edits reach it through a
+ *    lock-free queue.
  * =========================================
  */
 
 #include <SDL2/SDL.h>
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <memory>
+#include <vector>
 
+#include "AllocCounter.hpp"
 #include "ArgsToJson.hpp"
 #include "json.hpp"
 #include "ConwayLife.hpp"
+#include "Elementary.hpp"
+#include "Generations.hpp"
+#include "HashLife.hpp"
+#include "LargerThanLife.hpp"
+#include "Lenia.hpp"
 #include "SdlScreen.hpp"
+#include "SimulationThread.hpp"
+#include "SparseLife.hpp"
+#include "Turmite.hpp"
+#include "Wireworld.hpp"
 
 using json = nlohmann::json;
 
@@ -36,6 +69,16 @@ int main(int argc, char* argv[]) {
     int windowHeight = 800;
     int cellSize     = 10;
     int frameDelayMs = 50;
+    int gensPerFrame = 1;           // generations computed per frame
+    std::string modelName = "life"; // life (ConwayLife), hashlife, sparse, generations, ltl, lenia, elementary, turmite or wireworld
+    std::string engineName = "";    // "" = ConwayLife's default engine
+    std::string boundaryName = "";  // dead, toroidal, mirror, alive; "" = model default
+    std::string ruleName = "";      // Life-like (B36/S23), Generations (B2/S/C3), LtL (R5,...), Wolfram (30) or turmite (RL); "" = model default
+    bool allocCheck  = false;       // report heap allocations in step()/render()
+    int threads      = defaultThreadCount(); // row bands for life, ltl and lenia
+    std::string memoryName = "heap"; // life cell buffers: heap or huge (first-touch huge pages)
+    std::string pinName    = "none"; // life band workers: none, compact or spread
+    json modelArgs = json::object(); // model=ltl / lenia / turmite / wireworld fields (radius, birth, mu, ants, pattern, ...)
 
      // Attempt to read any JSON-style command-line arguments.
     try {
@@ -44,6 +87,17 @@ int main(int argc, char* argv[]) {
         if (args.contains("window_height")) windowHeight = args["window_height"];
         if (args.contains("cellSize"))      cellSize     = args["cellSize"];
         if (args.contains("frameDelayMs"))  frameDelayMs = args["frameDelayMs"];
+        if (args.contains("gensPerFrame"))  gensPerFrame = args["gensPerFrame"];
+        if (args.contains("model"))         modelName    = args["model"];
+        if (args.contains("engine"))        engineName   = args["engine"];
+        if (args.contains("boundary"))      boundaryName = args["boundary"];
+        if (args.contains("rule"))          ruleName     = args["rule"];
+        if (args.contains("allocCheck"))    allocCheck   = args["allocCheck"];
+        if (args.contains("threads"))       threads      = args["threads"];
+        if (args.contains("memory"))        memoryName   = args["memory"];
+        if (args.contains("pin"))           pinName      = args["pin"];
+        for (const char* key : {"radius", "birth", "survive", "middle", "mu", "sigma", "dt", "peaks", "ants", "pattern"})
+            if (args.contains(key))         modelArgs[key] = args[key];
     }
     catch (...) {
         std::cout << "Using default settings.\n";
@@ -53,11 +107,189 @@ int main(int argc, char* argv[]) {
     int rows = windowHeight / cellSize;
     int cols = windowWidth  / cellSize;
 
-    // Create the ConwayLife model
-    ConwayLife gol(rows, cols);
+    // Life-like rule for every model (unbounded ones reject B0)
+    LifeRule rule = LifeRule::conway();
+    try {
+        if ((modelName == "life" || modelName == "hashlife" || modelName == "sparse") && !ruleName.empty())
+            rule = LifeRule::parse(ruleName);
+    }
+    catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << " (using B3/S23)\n";
+    }
+
+    auto applyRule = [&](auto& life) {
+        try {
+            life.setRule(rule);
+        }
+        catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << " (using " << life.getRule().toString() << ")\n";
+        }
+    };
+
+    // Create the model. The HashLife and sparse universes are
+    // unbounded, so engine= only applies to ConwayLife and
+    // boundary= to the bounded boards (below).
+    std::unique_ptr<CellularAutomaton> model;
+
+    if (modelName == "hashlife") {
+        auto hash = std::make_unique<HashLife>(rows, cols);
+        applyRule(*hash);
+        model = std::move(hash);
+        model->randomize(0.25);
+    }
+    else if (modelName == "sparse") {
+        auto sparse = std::make_unique<SparseLife>(rows, cols);
+        applyRule(*sparse);
+        model = std::move(sparse);
+        model->randomize(0.25);
+    }
+    else if (modelName == "generations") {
+        auto gen = std::make_unique<Generations>(rows, cols);
+        try {
+            if (!ruleName.empty())
+                gen->setRule(GenerationsRule::parse(ruleName));
+        }
+        catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << " (using " << gen->getRule().toString() << ")\n";
+        }
+
+        model = std::move(gen);
+    }
+    else if (modelName == "ltl") {
+        auto ltl = std::make_unique<LargerThanLife>(rows, cols);
+        try {
+            LtLRule ltlRule = ruleName.empty() ? LtLRule::bosco() : LtLRule::parse(ruleName);
+            if (modelArgs.contains("radius")) ltlRule.radius = modelArgs["radius"];
+            if (modelArgs.contains("middle")) ltlRule.middle = modelArgs["middle"];
+            if (modelArgs.contains("birth")) {   // [lo, hi]
+                ltlRule.birthLo = modelArgs["birth"][0];
+                ltlRule.birthHi = modelArgs["birth"][1];
+            }
+            if (modelArgs.contains("survive")) { // [lo, hi]
+                ltlRule.surviveLo = modelArgs["survive"][0];
+                ltlRule.surviveHi = modelArgs["survive"][1];
+            }
+            ltl->setRule(ltlRule);
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << " (using " << ltl->getRule().toString() << ")\n";
+        }
+        ltl->setThreads(threads);
+
+        model = std::move(ltl);
+    }
+    else if (modelName == "lenia") {
+        auto lenia = std::make_unique<Lenia>(rows, cols);
+        try {
+            LeniaParams params;
+            if (modelArgs.contains("radius")) params.radius = modelArgs["radius"];
+            if (modelArgs.contains("mu"))     params.mu     = modelArgs["mu"];
+            if (modelArgs.contains("sigma"))  params.sigma  = modelArgs["sigma"];
+            if (modelArgs.contains("dt"))     params.dt     = modelArgs["dt"];
+            if (modelArgs.contains("peaks"))  params.peaks  = modelArgs["peaks"].get<std::vector<float>>();
+            lenia->setParams(params);
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << " (using Orbium)\n";
+        }
+        lenia->setThreads(threads);
+
+        model = std::move(lenia);
+    }
+    else if (modelName == "elementary") {
+        auto line = std::make_unique<Elementary>(rows, cols);
+        try {
+            if (!ruleName.empty())
+                line->setRule(parseElementaryRule(ruleName));
+        }
+        catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << " (using rule " << line->getRule() << ")\n";
+        }
+
+        model = std::move(line);
+    }
+    else if (modelName == "turmite") {
+        auto ants = std::make_unique<Turmites>(rows, cols);
+        try {
+            if (!ruleName.empty())
+                ants->setRule(TurmiteRule::parse(ruleName));
+        }
+        catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << " (using " << ants->getRule().toString() << ")\n";
+        }
+
+        // ants=N: N ants spread along the middle row, facing N, E, S, W in turn
+        int antCount = modelArgs.value("ants", 1);
+        if (antCount > 1) {
+            ants->clearAnts();
+            for (int i = 0; i < antCount; i++) ants->addAnt(rows / 2, (int64_t)cols * (i + 1) / (antCount + 1), i % 4);
+        }
+
+        model = std::move(ants);
+    }
+    else if (modelName == "wireworld") {
+        auto wires = std::make_unique<Wireworld>(rows, cols);
+        std::string path = modelArgs.value("pattern", std::string("assets/wireworld_clock.txt"));
+        try {
+            WireworldPattern circuit = WireworldPattern::load(path);
+            wires->place(circuit, (rows - circuit.rows) / 2, (cols - circuit.cols) / 2);
+        }
+        catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << " (empty board)\n";
+        }
+
+        model = std::move(wires);
+    }
+    else {
+        if (modelName != "life")
+            std::cerr << "Unknown model: " << modelName << " (using life)\n";
+
+        auto gol = std::make_unique<ConwayLife>(rows, cols);
+
+        if (!engineName.empty()) {
+            try {
+                gol->setEngine(engineName);
+            }
+            catch (const std::invalid_argument& e) {
+                std::cerr << e.what() << " (using " << gol->engineName() << ")\n";
+            }
+        }
+
+        applyRule(*gol);
+        gol->setThreads(threads);
+        try {
+            gol->setPinning(parseCpuPinning(pinName));
+            GridMemory memory = parseGridMemory(memoryName);
+            if (memory != GridMemory::Heap)
+                gol->setMemory(memory);
+        }
+        catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << "\n";
+        }
+
+        model = std::move(gol);
+    }
+
+    // Edge policy for the bounded boards ("" keeps the model's
+    // default: dead, or toroidal for Lenia)
+    bool unbounded = modelName == "hashlife" || modelName == "sparse" || modelName == "turmite";
+    if (!unbounded && !boundaryName.empty()) {
+        try {
+            model->setBoundary(parseBoundary(boundaryName));
+        }
+        catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << "\n";
+        }
+    }
 
     // Create SDL screen
     SdlScreen screen(windowWidth, windowHeight, cellSize);
+    if (modelName == "lenia")
+        screen.setPalette(SdlScreen::colormap());
+    else if (modelName == "wireworld")  // head blue, tail red, copper yellow
+        screen.setPalette({{40, 120, 255, 255}, {255, 60, 30, 255}, {230, 180, 40, 255}});
+    else
+        screen.setPalette(SdlScreen::fadePalette(model->stateCount()));
 
     
     // Load pattern definitions from JSON file
@@ -69,11 +301,38 @@ int main(int argc, char* argv[]) {
         std::cerr << "Error: Could not load shapes.json\n";
     }
 
+    // SIMULATION THREAD
+    // Steps the model and publishes finished generations; from here
+    // on this thread only sends it edits and draws its frames.
+    SimulationThread sim(*model, gensPerFrame, frameDelayMs);
+
+    // ALLOCATION CHECK STATE (allocCheck=true)
+    const int warmupFrames = 10;  // buffers are sized during these
+    int frame = 0;
+    size_t renderAllocs = 0;
+    if (allocCheck)
+        sim.countAllocations(warmupFrames);
+
      // MAIN EVENT LOOP STATE
     bool running = true; // controls outer loop
     bool paused  = false; // whether simulation is frozen
     SDL_Event event; // stores incoming SDL events
 
+    // Board edits go to the simulation thread (dropped if it has
+    // thousands queued already)
+    auto makeEdit = [](Edit::Kind kind, int r = 0, int c = 0, int value = 0) {
+        Edit e;
+        e.kind    = kind;
+        e.row     = r;
+        e.col     = c;
+        e.value   = value;
+        e.density = 0.25;  // Randomize
+        return e;
+    };
+    auto send = [&](Edit::Kind kind, int r = 0, int c = 0, int value = 0) {
+        sim.edit(makeEdit(kind, r, c, value));
+    };
+
     // MAIN GAME LOOP
     // Runs until user quits.
     while (running) {
@@ -98,29 +357,29 @@ int main(int argc, char* argv[]) {
                     // Pause or resume
                     case SDLK_SPACE:
                         paused = !paused;
+                        sim.setPaused(paused);
                         break;
 
                     // Step a single generation (only when paused)
                     case SDLK_n:
                         if (paused)
-                            gol.step();
+                            send(Edit::Step);
                         break;
 
                        // Randomize grid
-                    case SDLK_r: {
-                        auto& grid = const_cast<std::vector<std::vector<int>>&>(gol.getGrid());
-                        gol.randomize(0.25);
+                    case SDLK_r:
+                        send(Edit::Randomize);
                         break;
-                    }
 
                      // Clear grid (set all cells to 0)
-                    case SDLK_c: { 
-                        auto& grid = const_cast<std::vector<std::vector<int>>&>(gol.getGrid());
-                        for (int r = 0; r < rows; r++)
-                            for (int c = 0; c < cols; c++)
-                                grid[r][c] = 0;
+                    case SDLK_c:
+                        send(Edit::Clear);
+                        break;
+
+                    // Print engine / model statistics (e.g. active tiles)
+                    case SDLK_s:
+                        send(Edit::Stats);
                         break;
-                    }
 
                     // LOAD "GLIDER" PATTERN AT MOUSE POSITION
                     case SDLK_1: {
@@ -130,22 +389,20 @@ int main(int argc, char* argv[]) {
                         int centerRow = my / cellSize;
                         int centerCol = mx / cellSize;
 
-                        // Writable grid reference
-                        auto& grid = const_cast<std::vector<std::vector<int>>&>(gol.getGrid());
-
                         if (patterns.contains("shapes") &&
                             patterns["shapes"].contains("glider")) {
 
+                            // One group, so no generation sees half a glider
+                            std::vector<Edit> stamp;
                             for (auto& cell : patterns["shapes"]["glider"]["cells"]) {
 
                                 int r = centerRow + cell["y"].get<int>();
                                 int c = centerCol + cell["x"].get<int>();
 
-                                if (r >= 0 && r < rows &&
-                                    c >= 0 && c < cols) {
-                                    grid[r][c] = 1;
-                                }
+                                // setCell ignores cells outside the grid
+                                stamp.push_back(makeEdit(Edit::Set, r, c, 1));
                             }
+                            sim.edit(stamp.data(), stamp.size());
                         }
                         break;
                     }
@@ -159,22 +416,34 @@ int main(int argc, char* argv[]) {
                 if (screen.getCellFromMouse(event.button.x,
                                             event.button.y, r, c)) {
 
-                    auto& grid = const_cast<std::vector<std::vector<int>>&>(gol.getGrid());
-                    grid[r][c] = !grid[r][c];
+                    send(Edit::Toggle, r, c);
                 }
             }
         }
 
         
-        // MODEL UPDATE
-        if (!paused)
-            gol.step();
+        // DRAW THE NEWEST FINISHED GENERATION (never waits for the
+        // simulation; redraws the last frame if nothing new is ready)
+        ThreadAllocationScope renderScope;
+        screen.render(sim.latest().view());
+        size_t renderCount = renderScope.count();
+
+        // After warm-up, render() should never allocate (counted on
+        // this thread only, apart from the simulation thread's step())
+        if (allocCheck && ++frame > warmupFrames)
+            renderAllocs += renderCount;
 
-        
-        // DRAW GRIDS AND CELLS
-        screen.render(gol.getGrid());
         screen.pause(frameDelayMs);
     }
 
+    sim.stop();
+
+    if (allocCheck) {
+        std::cout << "Allocations after warm-up (" << std::max(0, sim.framesStepped() - warmupFrames)
+                  << " steps, " << std::max(0, frame - warmupFrames) << " frames): "
+                  << "step() = " << sim.stepAllocations() << " (simulation thread), render() = " << renderAllocs
+                  << " (main thread)\n";
+    }
+
     return 0;
 }
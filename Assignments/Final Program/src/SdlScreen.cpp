@@ -12,12 +12,14 @@
  */
 
 #include "SdlScreen.hpp"
+#include <algorithm>
 #include <iostream>
 
 SdlScreen::SdlScreen(int w, int h, int cell) {
     windowWidth  = w;
     windowHeight = h;
     cellSize     = cell;
+    setPalette(fadePalette(2));
 
     // Initialize SDL
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
@@ -57,20 +59,29 @@ SdlScreen::~SdlScreen() {
     SDL_Quit();
 }
 
-void SdlScreen::render(const std::vector<std::vector<int>>& grid) {
+void SdlScreen::render(const GridView& grid) {
     // Background color (dark)
     SDL_SetRenderDrawColor(renderer, 25, 25, 35, 255);
     SDL_RenderClear(renderer);
 
-    int rows = grid.size();
-    int cols = grid[0].size();
+    int rows = grid.rowCount();
+    int cols = grid.colCount();
 
-    // Draw alive cells (light gray)
-    SDL_SetRenderDrawColor(renderer, 220, 220, 230, 255);
+    // Draw non-zero cells, switching color only when the state changes
+    int drawn = -1;
 
     for (int r = 0; r < rows; r++) {
+        GridView::Row row = grid[r];
+
         for (int c = 0; c < cols; c++) {
-            if (grid[r][c] == 1) {
+            uint8_t state = row[c];
+            if (state != 0) {
+                if (state != drawn) {
+                    const SDL_Color& color = palette[state];
+                    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255);
+                    drawn = state;
+                }
+
                 SDL_Rect box;
                 box.x = c * cellSize;
                 box.y = r * cellSize;
@@ -96,6 +107,45 @@ void SdlScreen::render(const std::vector<std::vector<int>>& grid) {
     SDL_RenderPresent(renderer);
 }
 
+void SdlScreen::setPalette(const std::vector<SDL_Color>& colors) {
+    palette[0] = SDL_Color{25, 25, 35, 255};
+    for (size_t s = 1; s < palette.size(); s++) {
+        if (colors.empty())
+            palette[s] = SDL_Color{220, 220, 230, 255};
+        else
+            palette[s] = colors[std::min(s, colors.size()) - 1];
+    }
+}
+
+std::vector<SDL_Color> SdlScreen::fadePalette(int states) {
+    // Alive: light gray. Dying: blue, fading toward the background.
+    std::vector<SDL_Color> colors = {SDL_Color{220, 220, 230, 255}};
+    for (int s = 2; s < states; s++) {
+        double t = (double)(s - 2) / (states - 1);
+        colors.push_back(SDL_Color{(Uint8)(80 + (25 - 80) * t), (Uint8)(130 + (25 - 130) * t),
+                                   (Uint8)(230 + (35 - 230) * t), 255});
+    }
+    return colors;
+}
+
+std::vector<SDL_Color> SdlScreen::colormap() {
+    // Color stops at states 0, 64, 128, 192, 255
+    const int stops[5][3] = {{25, 25, 35}, {60, 30, 120}, {180, 50, 110}, {250, 140, 40}, {255, 250, 190}};
+
+    std::vector<SDL_Color> colors;
+    for (int s = 1; s <= 255; s++) {
+        int i    = std::min(3, s / 64);
+        double t = (s - i * 64) / (i == 3 ? 63.0 : 64.0);
+        SDL_Color color;
+        color.r = (Uint8)(stops[i][0] + (stops[i + 1][0] - stops[i][0]) * t);
+        color.g = (Uint8)(stops[i][1] + (stops[i + 1][1] - stops[i][1]) * t);
+        color.b = (Uint8)(stops[i][2] + (stops[i + 1][2] - stops[i][2]) * t);
+        color.a = 255;
+        colors.push_back(color);
+    }
+    return colors;
+}
+
 void SdlScreen::pause(int ms) {
     SDL_Delay(ms);
 }